@@ -0,0 +1,842 @@
+/*
+ * @file FuzzHarness.cpp
+ * @author Katarina McGaughy
+ * FuzzHarness: builds random graphs, applies random sequences of edge
+ * inserts, profile inserts, removals and direction changes and, after
+ * every step, compares the answers of every search of the Graph class
+ * with Bellman-Ford run on the edges the harness inserted. Built with
+ * AddressSanitizer and UndefinedBehaviorSanitizer by "make fuzz".
+ *
+ * Features:
+ * -usage: fuzz [seed] [rounds] [--time]
+ * -random graphs are directed or undirected, have travel time
+ * profiles on some edges and may be reordered, compressed,
+ * partitioned, have their next hops found, use a path cache file or
+ * be switched between directed and undirected
+ * -checks findShortestPath (through displayAll), findRoutes,
+ * findWithinDistance, findKShortestPaths, findAlternativeRoutes,
+ * findNearestSources, findEarliestArrival, findOverlayPath,
+ * displayRoute, findVertex and display, distances must match and
+ * every path must follow edges whose weights add up to its distance
+ * -findKShortestPaths is compared with every simple path of small
+ * graphs
+ * -copies made by the copy constructor and operator= are checked
+ * the same way
+ * -with --time the time each search took in total is printed
+ *
+ * Assumptions:
+ * -the working directory is writable, the graph and path cache
+ * files are written there and removed at the end
+ *
+ * @version 0.1
+ * @date 2022-2-3
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include "Graph.h"
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+//distance of a vertex with no path
+const int NO_PATH = numeric_limits<int>::max();
+
+//file the random graphs are written to for buildGraph
+const char* const GRAPH_FILE = "fuzz_graph.txt";
+
+//path cache file of the rounds that use one
+const char* const CACHE_FILE = "fuzz_paths.bin";
+
+//number of paths asked of findKShortestPaths and
+//findAlternativeRoutes, and the most vertices of a graph whose
+//simple paths are all listed to check findKShortestPaths
+const int ROUTE_COUNT = 3;
+const int LISTED_SIZE = 9;
+
+//the edges the harness inserted, undirected edges are keyed by
+//(lower vertex, higher vertex), the weight of an edge with a travel
+//time profile is its lowest travel time
+struct EdgeSet {
+	int size = 0;
+	bool undirected = false;
+	map<pair<int, int>, int> weight;
+	map<pair<int, int>, vector<pair<int, int>>> profile;
+	vector<string> name;
+
+	pair<int, int> key(int source, int dest) const {
+		if (undirected && dest < source) {
+			return make_pair(dest, source);
+		}
+		return make_pair(source, dest);
+	}
+};
+
+//total time spent in each search when timing
+map<string, double> searchTime;
+bool timing = false;
+
+/**
+* bellmanFord
+* this function finds the shortest distances from source with
+* Bellman-Ford, which shares no code with the Graph searches
+* Preconditions: source is a vertex of edges
+* Postconditions: returns the distance of every vertex, NO_PATH if
+* source does not reach it
+* @param edges: the edges of the graph
+* @param source: the source vertex
+*/
+vector<int> bellmanFord(const EdgeSet& edges, int source) {
+	vector<int> dist(edges.size + 1, NO_PATH);
+	dist[source] = 0;
+	bool changed = true;
+	for (int round = 1; round < edges.size && changed; round++) {
+		changed = false;
+		for (const auto& edge : edges.weight) {
+			for (int side = 0; side < (edges.undirected ? 2 : 1); side++) {
+				int from = side == 0 ? edge.first.first : edge.first.second;
+				int to = side == 0 ? edge.first.second : edge.first.first;
+				if (dist[from] != NO_PATH && dist[from] + edge.second < dist[to]) {
+					dist[to] = dist[from] + edge.second;
+					changed = true;
+				}
+			}
+		}
+	}
+	return dist;
+}
+
+/**
+* travel
+* this function returns the travel time of an edge entered at time
+* departure, interpolated between the breakpoints of its profile
+* Preconditions: the edge is in edges
+* Postconditions: returns the travel time of the edge
+* @param edges: the edges of the graph
+* @param edge: the key of the edge
+* @param departure: the time the edge is entered
+*/
+int travel(const EdgeSet& edges, const pair<int, int>& edge, int departure) {
+	auto found = edges.profile.find(edge);
+	if (found == edges.profile.end()) {
+		return edges.weight.at(edge);
+	}
+	const vector<pair<int, int>>& points = found->second;
+	size_t after = 0;
+	while (after < points.size() && points[after].first <= departure) {
+		after++;
+	}
+	if (after == 0) {
+		return points.front().second;
+	}
+	if (after == points.size()) {
+		return points.back().second;
+	}
+	const pair<int, int>& before = points[after - 1];
+	return before.second + static_cast<int>(static_cast<long long>(points[after].second -
+		before.second) * (departure - before.first) / (points[after].first - before.first));
+}
+
+/**
+* arrivals
+* this function finds the earliest time of arriving at every vertex
+* when leaving source at time departure with Bellman-Ford, relaxing
+* each edge at the time it is entered
+* Preconditions: source is a vertex of edges
+* Postconditions: returns the arrival time at every vertex, NO_PATH
+* if source does not reach it
+* @param edges: the edges of the graph
+* @param source: the source vertex
+* @param departure: the time of leaving source
+*/
+vector<int> arrivals(const EdgeSet& edges, int source, int departure) {
+	vector<int> time(edges.size + 1, NO_PATH);
+	time[source] = departure;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (const auto& edge : edges.weight) {
+			for (int side = 0; side < (edges.undirected ? 2 : 1); side++) {
+				int from = side == 0 ? edge.first.first : edge.first.second;
+				int to = side == 0 ? edge.first.second : edge.first.first;
+				if (time[from] != NO_PATH && time[from] + travel(edges, edge.first, time[from]) < time[to]) {
+					time[to] = time[from] + travel(edges, edge.first, time[from]);
+					changed = true;
+				}
+			}
+		}
+	}
+	return time;
+}
+
+/**
+* simplePaths
+* this function lists the length of every path from source to dest
+* that does not visit a vertex twice by trying every one
+* Preconditions: the graph is small
+* Postconditions: returns the lengths, shortest first
+* @param edges: the edges of the graph
+* @param source: the source vertex
+* @param dest: the destination vertex
+*/
+vector<int> simplePaths(const EdgeSet& edges, int source, int dest) {
+	vector<vector<pair<int, int>>> out(edges.size + 1);
+	for (const auto& edge : edges.weight) {
+		if (edge.first.first != edge.first.second) {
+			out[edge.first.first].push_back(make_pair(edge.first.second, edge.second));
+			if (edges.undirected) {
+				out[edge.first.second].push_back(make_pair(edge.first.first, edge.second));
+			}
+		}
+	}
+	vector<int> lengths;
+	vector<bool> onPath(edges.size + 1, false);
+	//depth first over the paths from v of length so far
+	function<void(int, int)> extend = [&](int v, int length) {
+		if (v == dest) {
+			lengths.push_back(length);
+			return;
+		}
+		onPath[v] = true;
+		for (const pair<int, int>& next : out[v]) {
+			if (!onPath[next.first]) {
+				extend(next.first, length + next.second);
+			}
+		}
+		onPath[v] = false;
+	};
+	extend(source, 0);
+	sort(lengths.begin(), lengths.end());
+	return lengths;
+}
+
+/**
+* check
+* this function compares one answer of a search with Bellman-Ford,
+* a path must start at source, end at dest and follow edges whose
+* weights add up to dist, an empty path is not checked
+* Preconditions: none
+* Postconditions: returns true if the answer is right, otherwise
+* the mismatch is printed
+* @param search: name of the search
+* @param edges: the edges of the graph
+* @param source: the source vertex
+* @param dest: the destination vertex
+* @param dist: the distance found by the search
+* @param path: the path found by the search
+* @param expected: the Bellman-Ford distance
+*/
+bool check(const char* search, const EdgeSet& edges, int source, int dest,
+	int dist, const vector<int>& path, int expected) {
+	bool valid = dist == expected;
+	if (valid && dist != NO_PATH && !path.empty()) {
+		long long length = 0;
+		valid = path.front() == source && path.back() == dest;
+		for (size_t i = 1; valid && i < path.size(); i++) {
+			auto edge = edges.weight.find(edges.key(path[i - 1], path[i]));
+			valid = edge != edges.weight.end();
+			length += valid ? edge->second : 0;
+		}
+		valid = valid && length == dist;
+	}
+	if (!valid) {
+		cout << search << " mismatch from " << source << " to " << dest << ": found ";
+		cout << (dist == NO_PATH ? string("--") : to_string(dist)) << ", expected ";
+		cout << (expected == NO_PATH ? string("--") : to_string(expected)) << endl;
+	}
+	return valid;
+}
+
+/**
+* checkRoutes
+* this function checks the Routes of findKShortestPaths or
+* findAlternativeRoutes, up to k different paths that do not visit a
+* vertex twice, shortest first and starting with the shortest path,
+* if lengths is given the Routes must be the k shortest of them
+* Preconditions: none
+* Postconditions: returns true if the Routes are right, otherwise
+* the mismatch is printed
+* @param search: name of the search
+* @param edges: the edges of the graph
+* @param source: the source vertex
+* @param dest: the destination vertex
+* @param routes: the Routes found by the search
+* @param k: the number of paths asked for
+* @param expected: the Bellman-Ford distance
+* @param lengths: every simple path length, shortest first, or null
+*/
+bool checkRoutes(const char* search, const EdgeSet& edges, int source, int dest,
+	const vector<Graph::Route>& routes, int k, int expected, const vector<int>* lengths) {
+	if (expected == NO_PATH || routes.empty()) {
+		return check(search, edges, source, dest, routes.empty() ? NO_PATH : routes[0].dist,
+			routes.empty() ? vector<int>() : routes[0].path, expected);
+	}
+	bool valid = static_cast<int>(routes.size()) <= k;
+	if (lengths != nullptr) {
+		valid = valid && routes.size() == min(static_cast<size_t>(k), lengths->size());
+	}
+	for (size_t i = 0; valid && i < routes.size(); i++) {
+		int shortest = i == 0 ? expected : routes[i - 1].dist;
+		valid = routes[i].dist >= shortest && !routes[i].path.empty() &&
+			check(search, edges, source, dest, routes[i].dist, routes[i].path,
+				lengths != nullptr ? (*lengths)[i] : i == 0 ? expected : routes[i].dist);
+		vector<int> sorted(routes[i].path);
+		sort(sorted.begin(), sorted.end());
+		valid = valid && adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+		for (size_t j = 0; valid && j < i; j++) {
+			valid = routes[j].path != routes[i].path;
+		}
+	}
+	if (!valid) {
+		cout << search << " routes from " << source << " to " << dest << " are wrong, found "
+			<< routes.size() << endl;
+	}
+	return valid;
+}
+
+/**
+* checkPrinted
+* this function checks the first line printed by displayRoute or
+* display, "source  dest  dist    path" or "source  dest  --"
+* Preconditions: none
+* Postconditions: returns true if the line is right
+* @param search: name of the search
+* @param edges: the edges of the graph
+* @param source: the source vertex
+* @param dest: the destination vertex
+* @param printed: the printed text
+* @param expected: the Bellman-Ford distance
+*/
+bool checkPrinted(const char* search, const EdgeSet& edges, int source, int dest,
+	const string& printed, int expected) {
+	istringstream line(printed.substr(0, printed.find('\n')));
+	int from = 0, to = 0, dist = NO_PATH;
+	string distText;
+	line >> from >> to >> distText;
+	vector<int> path;
+	if (distText != "--") {
+		dist = atoi(distText.c_str());
+		for (int v; line >> v; ) {
+			path.push_back(v);
+		}
+	}
+	return check(search, edges, source, dest, dist, path, expected);
+}
+
+/**
+* captured
+* this function runs print and returns what it sent to cout
+* Preconditions: none
+* Postconditions: returns the printed text
+* @param print: the function to run
+*/
+template <typename Print>
+string captured(Print print) {
+	ostringstream printed;
+	streambuf* screen = cout.rdbuf(printed.rdbuf());
+	print();
+	cout.rdbuf(screen);
+	return printed.str();
+}
+
+/**
+* timed
+* this function runs search and adds its time to searchTime
+* Preconditions: none
+* Postconditions: search has been run
+* @param name: name of the search
+* @param search: the search to run
+*/
+template <typename Search>
+void timed(const string& name, Search search) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	search();
+	searchTime[name] += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+* checkGraph
+* this function compares every search of G with Bellman-Ford
+* Preconditions: findShortestPath has been called since the last
+* edit, the next hops have been found if hops is true and the graph
+* has been partitioned if cells is true
+* Postconditions: returns true if every search is right
+* @param G: the graph to check
+* @param edges: the edges inserted into G
+* @param hops: whether to check displayRoute
+* @param cells: whether to check findOverlayPath
+* @param rng: the random number generator, picks the sources of
+* findNearestSources and the departure times
+*/
+bool checkGraph(const Graph& G, const EdgeSet& edges, bool hops, bool cells, mt19937& rng) {
+	int n = edges.size;
+	vector<vector<int>> expected(n + 1);
+	timed("Bellman-Ford", [&] {
+		for (int s = 1; s <= n; s++) {
+			expected[s] = bellmanFord(edges, s);
+		}
+	});
+	bool passed = true;
+
+	//Table T is read back through the CSV rows of displayAll
+	ostringstream table;
+	timed("displayAll", [&] { G.displayAll(table, Graph::CSV_FORMAT); });
+	istringstream rows(table.str());
+	string row;
+	getline(rows, row);
+	while (getline(rows, row)) {
+		int s = 0, d = 0, dist = NO_PATH;
+		char dists[16] = "";
+		char pathText[1024] = "";
+		sscanf(row.c_str(), "%d,%d,%15[^,],%1023[^\n]", &s, &d, dists, pathText);
+		if (dists[0] != '\0') {
+			dist = atoi(dists);
+		}
+		vector<int> path;
+		istringstream vertices(pathText);
+		for (int v; vertices >> v; ) {
+			path.push_back(v);
+		}
+		passed = check("findShortestPath", edges, s, d, dist, path, expected[s][d]) && passed;
+	}
+
+	vector<int> everyVertex;
+	for (int d = 1; d <= n; d++) {
+		everyVertex.push_back(d);
+	}
+	for (int s = 1; s <= n; s++) {
+		vector<Graph::Route> routes;
+		timed("findRoutes", [&] { routes = G.findRoutes(s, everyVertex); });
+		for (int d = 1; d <= n; d++) {
+			const Graph::Route& route = routes[d - 1];
+			passed = check("findRoutes", edges, s, d, route.path.empty() ? NO_PATH : route.dist,
+				route.path, expected[s][d]) && passed;
+		}
+
+		vector<int> within(n + 1, NO_PATH);
+		timed("findWithinDistance", [&] {
+			for (const pair<int, int>& found : G.findWithinDistance(s, NO_PATH)) {
+				within[found.first] = found.second;
+			}
+		});
+		for (int d = 1; d <= n; d++) {
+			passed = check("findWithinDistance", edges, s, d, within[d], vector<int>(),
+				expected[s][d]) && passed;
+		}
+
+		//earliest arrival is checked against the profiles at one
+		//departure time from each source
+		int departure = rng() % 60;
+		vector<int> arrival;
+		timed("Bellman-Ford arrivals", [&] { arrival = arrivals(edges, s, departure); });
+		for (int d = 1; d <= n; d++) {
+			Graph::Route route;
+			timed("findEarliestArrival", [&] { route = G.findEarliestArrival(s, d, departure); });
+			int time = departure;
+			bool valid = route.path.empty() ? arrival[d] == NO_PATH :
+				route.path.front() == s && route.path.back() == d && arrival[d] == departure + route.dist;
+			for (size_t i = 1; valid && i < route.path.size(); i++) {
+				pair<int, int> edge = edges.key(route.path[i - 1], route.path[i]);
+				valid = edges.weight.count(edge) == 1;
+				time += valid ? travel(edges, edge, time) : 0;
+			}
+			if (!valid || (!route.path.empty() && time != arrival[d])) {
+				cout << "findEarliestArrival mismatch from " << s << " to " << d << " leaving at "
+					<< departure << endl;
+				passed = false;
+			}
+		}
+
+		for (int d = 1; d <= n; d++) {
+			//every simple path of a small graph is listed, larger
+			//graphs only check a quarter of the pairs
+			vector<int> lengths;
+			if (n <= LISTED_SIZE) {
+				lengths = simplePaths(edges, s, d);
+			}
+			if (n <= LISTED_SIZE || rng() % 4 == 0) {
+				vector<Graph::Route> shortest;
+				timed("findKShortestPaths", [&] { shortest = G.findKShortestPaths(s, d, ROUTE_COUNT); });
+				passed = checkRoutes("findKShortestPaths", edges, s, d, shortest, ROUTE_COUNT,
+					expected[s][d], n <= LISTED_SIZE ? &lengths : nullptr) && passed;
+
+				vector<Graph::Route> alternatives;
+				timed("findAlternativeRoutes", [&] {
+					alternatives = G.findAlternativeRoutes(s, d, ROUTE_COUNT);
+				});
+				passed = checkRoutes("findAlternativeRoutes", edges, s, d, alternatives, ROUTE_COUNT,
+					expected[s][d], nullptr) && passed;
+			}
+
+			if (cells) {
+				Graph::Route route;
+				timed("findOverlayPath", [&] { route = G.findOverlayPath(s, d); });
+				passed = check("findOverlayPath", edges, s, d,
+					route.path.empty() ? NO_PATH : route.dist, route.path, expected[s][d]) && passed;
+			}
+
+			if (hops) {
+				string printed;
+				timed("displayRoute", [&] { printed = captured([&] { G.displayRoute(s, d); }); });
+				passed = checkPrinted("displayRoute", edges, s, d, printed, expected[s][d]) && passed;
+			}
+		}
+	}
+
+	//each vertex is found by its description, a description used
+	//twice finds the first vertex with it
+	auto firstWith = [&edges](const string& name) {
+		return static_cast<int>(find(edges.name.begin() + 1, edges.name.end(), name) -
+			edges.name.begin());
+	};
+	for (int v = 1; v <= n; v++) {
+		int found = 0;
+		timed("findVertex", [&] { found = G.findVertex(edges.name[v]); });
+		if (found != firstWith(edges.name[v])) {
+			cout << "findVertex of " << edges.name[v] << " found " << found << ", expected "
+				<< firstWith(edges.name[v]) << endl;
+			passed = false;
+		}
+	}
+	if (G.findVertex("no such vertex") != 0) {
+		cout << "findVertex found a missing description" << endl;
+		passed = false;
+	}
+	for (int count = 0; count < n; count++) {
+		int s = firstWith(edges.name[1 + rng() % n]);
+		int d = firstWith(edges.name[1 + rng() % n]);
+		string byName;
+		timed("display", [&] {
+			byName = captured([&] { G.display(edges.name[s], edges.name[d]); });
+		});
+		if (byName != captured([&] { G.display(s, d); })) {
+			cout << "display of " << edges.name[s] << " and " << edges.name[d]
+				<< " differs from display of " << s << " and " << d << endl;
+			passed = false;
+		}
+		passed = checkPrinted("display", edges, s, d, byName, expected[s][d]) && passed;
+	}
+
+	//nearest sources, each label must be one of the k nearest
+	vector<int> sources;
+	for (int count = 1 + rng() % min(n, 4); static_cast<int>(sources.size()) < count; ) {
+		int v = 1 + rng() % n;
+		if (find(sources.begin(), sources.end(), v) == sources.end()) {
+			sources.push_back(v);
+		}
+	}
+	vector<int> offsets;
+	if (rng() % 2 == 0) {
+		for (size_t i = 0; i < sources.size(); i++) {
+			offsets.push_back(rng() % 10);
+		}
+	}
+	int k = 1 + rng() % 3;
+	vector<vector<Graph::SourceLabel>> labels;
+	timed("findNearestSources", [&] { labels = G.findNearestSources(sources, offsets, k); });
+	for (int v = 1; v <= n; v++) {
+		vector<int> nearest;
+		for (size_t i = 0; i < sources.size(); i++) {
+			if (expected[sources[i]][v] != NO_PATH) {
+				nearest.push_back((offsets.empty() ? 0 : offsets[i]) + expected[sources[i]][v]);
+			}
+		}
+		sort(nearest.begin(), nearest.end());
+		nearest.resize(min(nearest.size(), static_cast<size_t>(k)));
+		bool valid = labels[v].size() == nearest.size();
+		for (size_t j = 0; valid && j < nearest.size(); j++) {
+			const Graph::SourceLabel& label = labels[v][j];
+			size_t i = find(sources.begin(), sources.end(), label.source) - sources.begin();
+			valid = i < sources.size() && label.dist == nearest[j] &&
+				label.dist == (offsets.empty() ? 0 : offsets[i]) + expected[label.source][v] &&
+				(label.path == 0 ? v == label.source :
+					edges.weight.count(edges.key(label.path, v)) == 1);
+			for (size_t other = 0; valid && other < j; other++) {
+				valid = labels[v][other].source != label.source;
+			}
+		}
+		if (!valid) {
+			cout << "findNearestSources labels of " << v << " are wrong" << endl;
+			passed = false;
+		}
+	}
+	return passed;
+}
+
+/**
+* randomProfile
+* this function returns a random FIFO travel time profile, travel
+* time never falls faster than time passes
+* Preconditions: none
+* Postconditions: returns 1 to 4 (departure time, travel time)
+* breakpoints in order of departure time
+* @param rng: the random number generator
+*/
+vector<pair<int, int>> randomProfile(mt19937& rng) {
+	vector<pair<int, int>> points(1, make_pair(static_cast<int>(rng() % 20),
+		static_cast<int>(rng() % 20)));
+	for (int count = rng() % 4; count > 0; count--) {
+		int gap = 1 + rng() % 10;
+		int travelTime = max(0, points.back().second - gap + static_cast<int>(rng() % (gap + 15)));
+		points.push_back(make_pair(points.back().first + gap, travelTime));
+	}
+	return points;
+}
+
+/**
+* setEdge
+* this function records an edge inserted with weight, or with
+* profile if it is not empty, whose lowest travel time is then the
+* weight
+* Preconditions: none
+* Postconditions: the edge is in edges
+* @param edges: the edges of the graph
+* @param source: the source vertex
+* @param dest: the destination vertex
+* @param weight: the weight of the edge, unused with a profile
+* @param profile: the breakpoints of the edge or empty
+*/
+void setEdge(EdgeSet& edges, int source, int dest, int weight,
+	const vector<pair<int, int>>& profile) {
+	pair<int, int> edge = edges.key(source, dest);
+	edges.profile.erase(edge);
+	if (!profile.empty()) {
+		edges.profile[edge] = profile;
+		weight = profile[0].second;
+		for (const pair<int, int>& point : profile) {
+			weight = min(weight, point.second);
+		}
+	}
+	edges.weight[edge] = weight;
+}
+
+/**
+* switchDirection
+* this function records setUndirected, an undirected edge becomes
+* one edge each way and the two directions of a pair become one edge
+* with the weight of the one from the lower vertex number
+* Preconditions: none
+* Postconditions: edges are undirected if they were directed and
+* directed if they were undirected
+* @param edges: the edges of the graph
+*/
+void switchDirection(EdgeSet& edges) {
+	EdgeSet switched;
+	switched.size = edges.size;
+	switched.undirected = !edges.undirected;
+	switched.name = edges.name;
+	//the edges from lower vertex numbers are recorded last so they win
+	for (int lowerFirst = 0; lowerFirst < 2; lowerFirst++) {
+		for (const auto& edge : edges.weight) {
+			int source = edge.first.first;
+			int dest = edge.first.second;
+			if (edges.undirected ? lowerFirst == 1 : (source < dest) != (lowerFirst == 1)) {
+				continue;
+			}
+			auto found = edges.profile.find(edge.first);
+			vector<pair<int, int>> profile = found == edges.profile.end() ?
+				vector<pair<int, int>>() : found->second;
+			setEdge(switched, source, dest, edge.second, profile);
+			if (edges.undirected && lowerFirst == 0) {
+				setEdge(switched, dest, source, edge.second, profile);
+			}
+		}
+	}
+	edges = switched;
+}
+
+/**
+* checkCopies
+* this function checks a copy of G made by the copy constructor and
+* one made by operator=
+* Preconditions: the same as checkGraph
+* Postconditions: returns true if both copies pass checkGraph
+* @param G: the graph to copy
+* @param edges: the edges inserted into G
+* @param hops: whether to check displayRoute
+* @param cells: whether to check findOverlayPath
+* @param rng: the random number generator
+*/
+bool checkCopies(const Graph& G, const EdgeSet& edges, bool hops, bool cells, mt19937& rng) {
+	Graph* copied = nullptr;
+	timed("copy constructor", [&] { copied = new Graph(G); });
+	bool passed = checkGraph(*copied, edges, hops, cells, rng);
+	Graph assigned;
+	timed("operator=", [&] { assigned = *copied; });
+	delete copied;
+	if (!passed) {
+		cout << "copy constructor failed" << endl;
+		return false;
+	}
+	if (!checkGraph(assigned, edges, hops, cells, rng)) {
+		cout << "operator= failed" << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+* runRound
+* this function builds one random graph and checks every search
+* after each edit of a random edit sequence
+* Preconditions: none
+* Postconditions: returns true if every check passed
+* @param rng: the random number generator
+* @param round: the number of the round, printed on failure
+*/
+bool runRound(mt19937& rng, int round) {
+	EdgeSet edges;
+	edges.size = 2 + rng() % 40;
+	edges.undirected = rng() % 2 == 0;
+
+	//write the vertices, some descriptions are used twice, and the
+	//first edges to the graph file, a quarter of them with profiles
+	ofstream outfile(GRAPH_FILE);
+	outfile << edges.size << "\n";
+	edges.name.push_back("");
+	for (int v = 1; v <= edges.size; v++) {
+		edges.name.push_back("vertex " + to_string(1 + rng() % edges.size));
+		outfile << edges.name[v] << "\n";
+	}
+	int count = rng() % (2 * edges.size);
+	for (int i = 0; i < count; i++) {
+		int source = 1 + rng() % edges.size;
+		int dest = 1 + rng() % edges.size;
+		int weight = rng() % 20;
+		vector<pair<int, int>> profile;
+		if (rng() % 4 == 0) {
+			profile = randomProfile(rng);
+		}
+		setEdge(edges, source, dest, weight, profile);
+		outfile << source << " " << dest << " ";
+		if (profile.empty()) {
+			outfile << weight << "\n";
+		}
+		else {
+			outfile << -static_cast<int>(profile.size());
+			for (const pair<int, int>& point : profile) {
+				outfile << " " << point.first << " " << point.second;
+			}
+			outfile << "\n";
+		}
+	}
+	outfile << "0 0 0\n";
+	outfile.close();
+
+	Graph G;
+	G.setUndirected(edges.undirected);
+	//the results of findShortestPath are written to the cache file
+	//and mapped from it when asked for again
+	bool cached = rng() % 4 == 0;
+	if (cached) {
+		remove(CACHE_FILE);
+		G.setPathCache(CACHE_FILE);
+	}
+	ifstream infile(GRAPH_FILE);
+	timed("buildGraph", [&] { G.buildGraph(infile); });
+	infile.close();
+	if (rng() % 3 == 0) {
+		G.reorderVertices(rng() % 2 == 0 ? Graph::RCM_ORDER : Graph::DEGREE_ORDER);
+	}
+	if (rng() % 2 == 0) {
+		G.buildReachability();
+	}
+
+	//edits are 0 for a check of the graph as built
+	int editCount = 1 + rng() % 12;
+	for (int edit = 0; edit < editCount; edit++) {
+		if (edit > 0) {
+			int source = 1 + rng() % edges.size;
+			int dest = 1 + rng() % edges.size;
+			int kind = rng() % 12;
+			if (kind < 6) {
+				int weight = rng() % 20;
+				G.insertEdge(source, dest, weight);
+				setEdge(edges, source, dest, weight, vector<pair<int, int>>());
+			}
+			else if (kind < 8) {
+				vector<pair<int, int>> profile = randomProfile(rng);
+				G.insertEdge(source, dest, profile);
+				setEdge(edges, source, dest, 0, profile);
+			}
+			else if (kind < 11) {
+				bool removed = G.removeEdge(source, dest);
+				pair<int, int> edge = edges.key(source, dest);
+				edges.profile.erase(edge);
+				if (removed != (edges.weight.erase(edge) == 1)) {
+					cout << "removeEdge from " << source << " to " << dest << " returned "
+						<< removed << endl;
+					return false;
+				}
+			}
+			else {
+				timed("setUndirected", [&] { G.setUndirected(!edges.undirected); });
+				switchDirection(edges);
+			}
+		}
+		if (rng() % 3 == 0) {
+			G.compressEdges();
+		}
+		bool cells = rng() % 3 == 0;
+		if (cells) {
+			G.partitionGraph(1 + rng() % 8);
+		}
+		bool hops = rng() % 3 == 0;
+		if (hops) {
+			timed("findNextHops", [&] { G.findNextHops(); });
+		}
+		timed("findShortestPath", [&] { G.findShortestPath(); });
+		if (cached) {
+			timed("findShortestPath from cache", [&] { G.findShortestPath(); });
+		}
+		if (!checkGraph(G, edges, hops, cells, rng) ||
+			(rng() % 4 == 0 && !checkCopies(G, edges, hops, cells, rng))) {
+			cout << "round " << round << " edit " << edit << " failed" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	unsigned int seed = 1;
+	int rounds = 200;
+	int number = 0;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--time") == 0) {
+			timing = true;
+		}
+		else if (number++ == 0) {
+			seed = static_cast<unsigned int>(strtoul(argv[i], nullptr, 10));
+		}
+		else {
+			rounds = atoi(argv[i]);
+		}
+	}
+
+	mt19937 rng(seed);
+	bool passed = true;
+	for (int round = 0; round < rounds && passed; round++) {
+		passed = runRound(rng, round);
+	}
+	remove(GRAPH_FILE);
+	remove(CACHE_FILE);
+
+	if (timing) {
+		for (const auto& search : searchTime) {
+			cout << search.first << ": " << search.second << " ms" << endl;
+		}
+	}
+	cout << (passed ? "passed" : "FAILED") << " (seed " << seed << ")" << endl;
+	return passed ? 0 : 1;
+}
@@ -14,11 +14,36 @@
  * -assignment operator
  * -findShortesPath computes all shortest paths betweeen all
  * vertices and stores them
- * -displayAll prints out all of the graphs information
+ * -displayAll prints out all of the graphs information, as text,
+ * CSV or JSON lines, to any output stream
  * -display prints out path information between two vertices
+ * -reorderVertices relabels the vertices for memory locality while
+ * all public functions keep using the vertex numbers from the file
+ * -compressEdges stores the edges in a compact read only form
+ * -findNextHops stores all shortest paths as compressed next hop tables
+ * -setPathCache keeps the results of findShortestPath in a file so
+ * later runs on the same graph map them instead of recomputing them
+ * -findKShortestPaths and findAlternativeRoutes find several paths
+ * between two vertices
+ * -findNearestSources finds the nearest of many sources to every
+ * vertex in one search
+ * -findWithinDistance finds every vertex within a distance of a source
+ * -edges may have travel time profiles that depend on the time of
+ * departure, findEarliestArrival searches by the time of arrival
+ * -partitionGraph splits the graph into cells and builds an overlay
+ * of the cells that findOverlayPath searches
+ * -findRoutes answers several destinations from one source with one
+ * search, const searches may run on several threads at once
+ * -buildReachability finds the strongly connected components so that
+ * searches between vertices with no path are skipped
+ * -vertex descriptions are stored together in one string and can be
+ * looked up by findVertex
+ * -setUndirected stores each edge once for both directions and
+ * Table T only keeps the upper half of the shortest paths
  *
  * Assumptions:
- * -file is in correct format
+ * -file is in correct format, an edge line "src dest -n" is followed
+ * by the n (departure time, travel time) breakpoints of its profile
  * -valid vertices are entered along with
  * valid weights (non negative)
 
@@ -31,14 +56,20 @@
  *
  * TODO:
  * set maxNum : INTEGER.MAX_VALUE
- * removeEdge check to ensure it works...
- * redo print recursion??
  * comment all
  */
 
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include "Graph.h"
 #include <iostream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
 
@@ -50,6 +81,11 @@ using namespace std;
 * Postconditios: vertices array is initialized
 */
 Graph::Graph() {
+	//vertices start out stored in the order of the file
+	for (int v = 0; v < MAX_VERTICES; v++) {
+		toInternal[v] = v;
+		toOriginal[v] = v;
+	}
 }
 
 /**
@@ -79,21 +115,71 @@ void Graph::copyGraph(const Graph& copyGraph) {
 	//copy adjacency list
 	//copy vertices
 	for (int i = 1; i <= copyGraph.size; i++) {
-		vertices[i].data = new Vertex(*copyGraph.vertices[i].data);
+		vertices[i].nameStart = copyGraph.vertices[i].nameStart;
+		vertices[i].nameLength = copyGraph.vertices[i].nameLength;
 		vertices[i].edgeHead = copyGraphHelper(copyGraph.vertices[i].edgeHead);
 	}
+	namePool = copyGraph.namePool;
+	for (int slot = 0; slot < NAME_SLOTS; slot++) {
+		nameIndex[slot] = copyGraph.nameIndex[slot];
+	}
 
 	//copy size
 	size = copyGraph.size;
 
-	//copy table
-	for (int row = 0; row < MAX_VERTICES; row++)
-	{
-		for (int col = 0; col < MAX_VERTICES; col++)
-		{
-			T[row][col] = copyGraph.T[row][col];
-		}
+	//copy compressed edges
+	compressed = copyGraph.compressed;
+	packedEdges = copyGraph.packedEdges;
+	for (int v = 0; v <= MAX_VERTICES; v++) {
+		packedStart[v] = copyGraph.packedStart[v];
+	}
+
+	//copy undirected edges from lower positions
+	undirected = copyGraph.undirected;
+	lowerEdges = copyGraph.lowerEdges;
+	for (int v = 0; v <= MAX_VERTICES; v++) {
+		lowerStart[v] = copyGraph.lowerStart[v];
+	}
+
+	//copy travel time profiles
+	profileStart = copyGraph.profileStart;
+	profilePoints = copyGraph.profilePoints;
+	unusedPoints = copyGraph.unusedPoints;
+
+	//copy reachability index
+	reachValid = copyGraph.reachValid;
+	reaches = copyGraph.reaches;
+	for (int c = 0; c < MAX_VERTICES; c++) {
+		component[c] = copyGraph.component[c];
+		reachCount[c] = copyGraph.reachCount[c];
+	}
+
+	//copy cells and overlay
+	cellCount = copyGraph.cellCount;
+	for (int v = 0; v < MAX_VERTICES; v++) {
+		cellOf[v] = copyGraph.cellOf[v];
+		boundary[v] = copyGraph.boundary[v];
+	}
+	overlayEdges = copyGraph.overlayEdges;
+
+	//copy next hop tables
+	nextHopRuns = copyGraph.nextHopRuns;
+	for (int v = 0; v <= MAX_VERTICES; v++) {
+		nextHopStart[v] = copyGraph.nextHopStart[v];
+	}
+
+	//copy vertex number maps
+	for (int v = 0; v < MAX_VERTICES; v++) {
+		toInternal[v] = copyGraph.toInternal[v];
+		toOriginal[v] = copyGraph.toOriginal[v];
+	}
+
+	//copy table, the mapped rows of copyGraph are copied into it
+	T = copyGraph.T;
+	if (copyGraph.cachedRows != nullptr) {
+		T.assign(copyGraph.cachedRows, copyGraph.cachedRows + copyGraph.tableLength());
 	}
+	cacheFile = copyGraph.cacheFile;
 }
 
 /**
@@ -115,6 +201,7 @@ Graph::EdgeNode* Graph::copyGraphHelper(EdgeNode* vertexCopy) {
 	EdgeNode* newVertex = new EdgeNode();
 	newVertex->adjVertex = vertexCopy->adjVertex;
 	newVertex->weight = vertexCopy->weight;
+	newVertex->profile = vertexCopy->profile;
 
 	newVertex->nextEdge = copyGraphHelper(vertexCopy->nextEdge);
 
@@ -142,15 +229,26 @@ Graph::~Graph() {
  * Postconditios: adjacency list is deleted
  */
 void Graph::deleteList() {
+	unmapPathCache();
 	//need to delete edgenode and vertex node 
 	for (int source = 1; source <= size; source++) {
-		if (vertices[source].edgeHead != nullptr) {
-			deleteListHelper(vertices[source].edgeHead);
-			vertices[source].edgeHead = nullptr; //not sure if this is needed...
-			delete vertices[source].data;
-			vertices[source].data = nullptr;
-		}
+		deleteListHelper(vertices[source].edgeHead);
+		vertices[source].edgeHead = nullptr;
 	}
+	namePool.clear();
+	fill(nameIndex, nameIndex + NAME_SLOTS, 0);
+	compressed = false;
+	packedEdges.clear();
+	lowerEdges.clear();
+	fill(lowerStart, lowerStart + MAX_VERTICES + 1, 0);
+	nextHopRuns.clear();
+	profileStart.assign(1, 0);
+	profilePoints.clear();
+	unusedPoints = 0;
+	cellCount = 0;
+	overlayEdges.clear();
+	reachValid = false;
+	reaches.clear();
 }
 
 /**
@@ -203,22 +301,46 @@ void Graph::buildGraph(ifstream& infile) {
 	// throw away '\n' to go to next line
 	infile.ignore();
 
-	// get descriptions of vertices and add to vertices array
+	// vertices are stored in the order of the file until reordered
+	for (int v = 0; v < MAX_VERTICES; v++) {
+		toInternal[v] = v;
+		toOriginal[v] = v;
+	}
+
+	// get descriptions of vertices and add them to namePool, one
+	// Vertex is reused to read every line
+	namePool.clear();
+	fill(nameIndex, nameIndex + NAME_SLOTS, 0);
+	Vertex description;
 	for (int v = 1; v <= size; v++) {
-		vertices[v].data = new Vertex;
-		//add description to vertices initialized
-		infile >> *vertices[v].data;
+		infile >> description;
+		addName(v, description.getName());
 		vertices[v].edgeHead = nullptr;
 	}
+	indexLowerEdges();
+	loading = true;
 
-	// fill cost edge array
+	// fill cost edge array, a negative weight is the number of
+	// breakpoints of a travel time profile
 	int src = 1, dest = 1, weight = 1;
+	vector<pair<int, int>> profile;
 	for (;;) {
 		infile >> src >> dest >> weight;
 		if (src == 0 || infile.eof())
 			break;
-		insertEdge(src, dest, weight);
+		if (weight < 0) {
+			profile.resize(-weight);
+			for (pair<int, int>& point : profile) {
+				infile >> point.first >> point.second;
+			}
+			insertEdge(src, dest, profile);
+		}
+		else {
+			insertEdge(src, dest, weight);
+		}
 	}
+	loading = false;
+	indexLowerEdges();
 
 }
 
@@ -238,6 +360,76 @@ bool Graph::isValidVertex(int vertex) const {
 	return false;
 }
 
+/**
+* hashName
+* this function returns the FNV-1a hash of the length characters
+* starting at name
+* Preconditons: none
+* Postconditions: returns the hash of the name
+*/
+unsigned int Graph::hashName(const char* name, size_t length) {
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= static_cast<unsigned char>(name[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+* addName
+* this function appends the description of the vertex at position v
+* to namePool and adds the vertex to nameIndex unless another
+* vertex already has the same description
+* Preconditons: v is a position in the vertices array
+* Postconditions: the description of v is stored
+* @param v: position of the vertex
+* @param name: description of the vertex
+*/
+void Graph::addName(int v, const string& name) {
+	vertices[v].nameStart = static_cast<int>(namePool.size());
+	vertices[v].nameLength = static_cast<int>(name.size());
+	namePool += name;
+	if (findVertex(name) != 0) {
+		return;
+	}
+	//linear probing from the slot of the hash
+	unsigned int slot = hashName(name.data(), name.size()) & (NAME_SLOTS - 1);
+	while (nameIndex[slot] != 0) {
+		slot = (slot + 1) & (NAME_SLOTS - 1);
+	}
+	nameIndex[slot] = toOriginal[v];
+}
+
+/**
+* printName
+* this function prints the description of the vertex at position v
+* Preconditons: v is a position in the vertices array
+* Postconditions: the description is sent to os
+* @param os: output stream
+* @param v: position of the vertex
+*/
+void Graph::printName(ostream& os, int v) const {
+	os.write(namePool.data() + vertices[v].nameStart, vertices[v].nameLength);
+}
+
+/**
+* hasEdges
+* this function returns if any edge leaves vertex, in either
+* direction in undirected graphs
+* Preconditons: vertex is a position in the vertices array
+* Postconditions: returns true if vertex has an edge
+*/
+bool Graph::hasEdges(int vertex) const {
+	if (lowerStart[vertex] != lowerStart[vertex + 1]) {
+		return true;
+	}
+	if (compressed) {
+		return packedStart[vertex] != packedStart[vertex + 1];
+	}
+	return vertices[vertex].edgeHead != nullptr;
+}
+
 /**
 * insertEdge
 * this function takes in a source and dest
@@ -268,10 +460,22 @@ void Graph::insertEdge(int source, int dest, int weight) {
 		cout << "Weight can not be negative." << endl;
 		return;
 	}
+	source = toInternal[source];
+	dest = toInternal[dest];
+	//undirected edges are stored with the lower position
+	if (undirected && dest < source) {
+		swap(source, dest);
+	}
+	expandEdges();
+	unmapPathCache();
+	//next hops were found with the old edges
+	nextHopRuns.clear();
+	fill(nextHopStart, nextHopStart + MAX_VERTICES + 1, 0);
 	EdgeNode* edge = findEdge(source, dest);
 	//if edge exists 
 	if (edge != nullptr) {
 		edge->weight = weight;
+		releaseProfile(edge);
 	}
 	else {
 		EdgeNode* newNode = new EdgeNode();
@@ -281,6 +485,15 @@ void Graph::insertEdge(int source, int dest, int weight) {
 		vertices[source].edgeHead = newNode;
 	}
 	edge = nullptr;
+	if (undirected && !loading) {
+		updateLowerEdges(source, dest);
+	}
+	updateOverlay(source, dest);
+	//a new edge only changes the components if its source did not
+	//already reach its dest
+	if (!reachable(source, dest)) {
+		buildReachability();
+	}
 
 }
 
@@ -290,7 +503,8 @@ void Graph::insertEdge(int source, int dest, int weight) {
 * and traverses the adjacency list of EdgeNodes in order
 * to find if the edge exists, if it does, the EdgeNode is
 * returned and if it does not, nullptr is returned
-* this function is called by insert
+* this function is called by insert, in undirected graphs the
+* edge is looked up with the lower of source and dest
 * Precondtions: valid source must be entered
 * Postconditons: if edge is found, EdgeNode is returned, and if
 * it is not found, nullptr is returned
@@ -306,6 +520,9 @@ Graph::EdgeNode* Graph::findEdge(int source, int dest) const {
 		cout << "Invalid destination vertex entered." << endl;
 		return nullptr;
 	}
+	if (undirected && dest < source) {
+		swap(source, dest);
+	}
 	if (vertices[source].edgeHead == nullptr) {
 		return nullptr;
 	}
@@ -342,26 +559,42 @@ bool Graph::removeEdge(int source, int dest) {
 		cout << "Invalid destination vertex entered." << endl;
 		return false;
 	}
-	EdgeNode* curr = vertices[source].edgeHead;
-	//if edgeHead is destination
-	if (curr->adjVertex == dest) {
-		curr->nextEdge = curr->nextEdge->nextEdge;
-		delete curr;
-		curr = nullptr;
-		return true;
+	source = toInternal[source];
+	dest = toInternal[dest];
+	if (undirected && dest < source) {
+		swap(source, dest);
 	}
-	if (curr != nullptr) {
-		while (curr->nextEdge != nullptr) {
-			if (curr->nextEdge->adjVertex == dest) {
-				curr->nextEdge = curr->nextEdge->nextEdge;
-				delete curr->nextEdge;
-				curr = nullptr;
-				return true;
+	expandEdges();
+	unmapPathCache();
+	//next hops were found with the old edges
+	nextHopRuns.clear();
+	fill(nextHopStart, nextHopStart + MAX_VERTICES + 1, 0);
+	EdgeNode* prev = nullptr;
+	EdgeNode* curr = vertices[source].edgeHead;
+	while (curr != nullptr) {
+		if (curr->adjVertex == dest) {
+			releaseProfile(curr);
+			//unlink curr from the list, edgeHead if it is first
+			if (prev == nullptr) {
+				vertices[source].edgeHead = curr->nextEdge;
+			}
+			else {
+				prev->nextEdge = curr->nextEdge;
+			}
+			delete curr;
+			curr = nullptr;
+			if (undirected) {
+				updateLowerEdges(source, dest);
+			}
+			updateOverlay(source, dest);
+			if (reachValid) {
+				buildReachability();
 			}
-			curr = curr->nextEdge;
+			return true;
 		}
+		prev = curr;
+		curr = curr->nextEdge;
 	}
-	curr = nullptr;
 	return false;
 }
 
@@ -377,52 +610,99 @@ bool Graph::removeEdge(int source, int dest) {
 * is stored in the Table T
 */
 void Graph::findShortestPath() {
+	unmapPathCache();
+
+	//use the results in the cache file if they are for this graph
+	unsigned long long hash = 0;
+	if (!cacheFile.empty()) {
+		hash = graphHash();
+		if (mapPathCache(hash)) {
+			return;
+		}
+	}
+
 	//reset table values
-	resetTable();
+	T.assign(tableLength(), Table());
+	buildReachability();
 
+	//undirected rows are found in full and only the vertices after
+	//source are kept
+	vector<Table> upperRow(undirected ? size + 1 : 0);
+	Table* next = T.data();
 	for (int i = 1; i <= size; i++) {
-		//ensure source vertex is connected to another vertex
-		if (vertices[i].edgeHead != nullptr) {
-			dijkstrasAlgo(vertices[i], i);
+		Table* row = undirected ? upperRow.data() : next;
+		//ensure source vertex reaches another vertex, undirected rows
+		//only need the vertices after source
+		if (hasEdges(i) && reachCount[component[i]] > 1) {
+			dijkstrasAlgo(i, row, undirected);
+			if (undirected) {
+				copy(row + i + 1, row + size + 1, next);
+			}
+		}
+		else if (!undirected) {
+			//a vertex is always 0 away from itself
+			row[i].dist = 0;
 		}
+		next += undirected ? size - i : size + 1;
+	}
+
+	if (!cacheFile.empty()) {
+		writePathCache(hash);
 	}
 }
 
 
 /**
 * resetTable
-* this function resets the Table T
+* this function frees the Table T, findShortestPath
+* allocates it again
 * Preconditons: none
-* Postconditions: the tables values are reset to
-* their initial values
+* Postconditions: the Table T is empty
 */
 void Graph::resetTable() {
-	for (int source = 1; source <= size; source++) {
-		for (int dest = 1; dest <= size; dest++) {
-			T[source][dest].path = 0;
-			T[source][dest].visited = false;
-			T[source][dest].dist = numeric_limits<int>::max();
-		}
-	}
+	vector<Table>().swap(T);
 }
 
 /**
 * dijkstrasAlgo
-* this function takes in a VertexNode along with the
-* vertexNum which represents the VertexNode's vertex position
-* and perform dijkstraAlgo on the sourceVertex in order to
-* find the shortest path from the sourceVertex to
-* all other vertices in the graph (which is stored in Table T)
-* Preconditons: sourceVertex must be valid vertex
-* Postconditions: the shortest path information
-* is stored in the Table T
-* @param sourceVertex: the source vertex for the algorithm
-* @param vertexNum: the number vertex of sourceVertex
+* this function takes in the position of a source vertex and
+* performs dijkstraAlgo on it in order to find the shortest path
+* from the source to all other vertices in the graph, which is
+* stored in row (a row of Table T or any other row of size entries)
+* Preconditons: source must be valid vertex
+* Postconditions: the shortest path information is stored in row,
+* if upperOnly is true only the entries of vertices after source
+* (and the vertices on their paths) are final
+* @param source: the source vertex for the algorithm
+* @param row: the table row to store the shortest paths in
+* @param upperOnly: whether to stop once the vertices after source
+* are visited
 */
-void Graph::dijkstrasAlgo(VertexNode sourceVertex, int source) {
+void Graph::dijkstrasAlgo(int source, Table row[], bool upperOnly) const {
+
+	//start from an empty row
+	for (int dest = 1; dest <= size; dest++) {
+		row[dest] = Table();
+	}
 
 	//set distance of sourceVertex to 0
-	T[source][source].dist = 0;
+	row[source].dist = 0;
+
+	//stop once every vertex source reaches is visited, or every one
+	//after source for an upper row
+	int toVisit = reachValid ? reachCount[component[source]] : size;
+	if (upperOnly) {
+		toVisit = 0;
+		for (int dest = source + 1; dest <= size; dest++) {
+			if (reachable(source, dest)) {
+				toVisit++;
+			}
+		}
+		if (toVisit == 0) {
+			return;
+		}
+	}
+	int visitedCount = 0;
 
 	//have priority queue of adjacentVertices
 	priority_queue <AdjacentVertex, vector<AdjacentVertex>, CompareAdjacentVertex > pq;
@@ -443,31 +723,37 @@ void Graph::dijkstrasAlgo(VertexNode sourceVertex, int source) {
 		}
 	}
 
-	//repeat n-1 times
-	for (int i = 1; i < size; i++) {
+	//repeat until every reachable vertex is visited
+	while (!pq.empty()) {
 		AdjacentVertex minVertex = pq.top();
 		pq.pop();
-		if (T[source][minVertex.vertexIndex].visited == false) {
+		//remaining vertices can not be reached from source
+		if (minVertex.dist == numeric_limits<int>::max()) {
+			break;
+		}
+		if (row[minVertex.vertexIndex].visited == false) {
 			//set vertex first visited to visited
-			T[source][minVertex.vertexIndex].visited = true;
-
-			//have v represent the minVertex in pq
-			EdgeNode* v = vertices[minVertex.vertexIndex].edgeHead;
-			//while v is not nullptr
-			while (v != nullptr) {
-				int w = v->adjVertex;
-				if (T[source][w].visited == false &&
-					T[source][w].dist > T[source][minVertex.vertexIndex].dist + v->weight) {
-					T[source][w].dist = T[source][minVertex.vertexIndex].dist + v->weight;
+			row[minVertex.vertexIndex].visited = true;
+			if ((!upperOnly || minVertex.vertexIndex > source) &&
+				++visitedCount == toVisit) {
+				break;
+			}
+
+			//have v represent the edges of the minVertex in pq
+			EdgeIterator v(*this, minVertex.vertexIndex);
+			while (v.next()) {
+				int w = v.adjVertex;
+				if (row[w].visited == false &&
+					row[w].dist > row[minVertex.vertexIndex].dist + v.weight) {
+					row[w].dist = row[minVertex.vertexIndex].dist + v.weight;
 					//set previous vertex in shortest path to path in table
-					T[source][w].path = minVertex.vertexIndex;
+					row[w].path = minVertex.vertexIndex;
 					//add new pq with updated distance 
 					AdjacentVertex updated = AdjacentVertex();
-					updated.dist = T[source][w].dist;
+					updated.dist = row[w].dist;
 					updated.vertexIndex = w;
 					pq.push(updated);
 				}
-				v = v->nextEdge;
 			}
 		}
 	}
@@ -493,13 +779,11 @@ void Graph::printPath(int source, int dest) const {
 		cout << "Invalid destination vertex entered." << endl;
 		return;
 	}
-	if (vertices[source].edgeHead != nullptr) {
-		if (dest == source) {
-			return;
-		}
-		else {
-			printPath(source, dest = T[source][dest].path);
-			cout << dest << " ";
+	if (hasEdges(source)) {
+		//path is stored dest first and dest is not printed
+		int path[MAX_VERTICES];
+		for (int length = tablePath(source, dest, path); length > 1; length--) {
+			cout << toOriginal[path[length - 1]] << " ";
 		}
 	}
 }
@@ -525,12 +809,13 @@ void Graph::printDestinations(int source, int dest) const {
 		return;
 	}
 	//if there is a path from source to dest
-	if (vertices[source].edgeHead != nullptr) {
-		if (dest == source) {
-			return;
+	if (hasEdges(source)) {
+		//path is stored dest first and dest is not printed
+		int path[MAX_VERTICES];
+		for (int length = tablePath(source, dest, path); length > 1; length--) {
+			printName(cout, path[length - 1]);
+			cout << endl;
 		}
-		printDestinations(source, dest = T[source][dest].path);
-		cout << *vertices[dest].data << endl;
 	}
 }
 
@@ -545,43 +830,153 @@ void Graph::printDestinations(int source, int dest) const {
 * Postconditions: prints all the graphs information
 */
 void Graph::displayAll() const {
+	displayAll(cout);
+}
+
+/*
+* displayAll
+* this function writes the same information as displayAll() to os
+* in the given format, the output is built in a local buffer and
+* written to os in large blocks
+* Preconditions: none
+* Postconditions: writes all the graphs information to os
+* @param os: output stream to write to
+* @param format: TEXT_FORMAT, CSV_FORMAT or JSON_LINES_FORMAT
+*/
+void Graph::displayAll(ostream& os, OutputFormat format) const {
 	if (size == 0) {
-		cout << "No graph to print. Please enter graph." << endl;
+		os << "No graph to print. Please enter graph." << endl;
 		return;
 	}
-	cout << "Description";
-	cout << "                  From  To    Dist  Path" << endl;
-	for (int source = 1; source <= size; source++) {
-		//print out string representation of vertices
-		cout << *vertices[source].data << endl;
-		for (int dest = 1; dest <= size; dest++) {
-			if (dest != source) {
-				cout << "                             " << source;
-				cout << "     " << dest;
-				//if there is a path, print distance and shortest path
-				if (vertices[source].edgeHead != nullptr) {
-					if (T[source][dest].dist != numeric_limits<int>::max()) {
-						cout << "     " << T[source][dest].dist;
-						if (T[source][dest].dist < 10) {
-							cout << "     ";
-						}
-						else {
-							cout << "    ";
-						}
-						printPath(source, dest);
-						cout << dest << " " << endl;
+	//size of the blocks written to os
+	const size_t blockSize = 1 << 16;
+	string out;
+	out.reserve(blockSize + 1024);
+
+	if (format == TEXT_FORMAT) {
+		out += "Description                  From  To    Dist  Path\n";
+	}
+	else if (format == CSV_FORMAT) {
+		out += "from,to,dist,path\n";
+	}
+
+	int path[MAX_VERTICES];
+	for (int from = 1; from <= size; from++) {
+		int source = toInternal[from];
+		if (format == TEXT_FORMAT) {
+			//print out string representation of vertices
+			out.append(namePool, vertices[source].nameStart, vertices[source].nameLength);
+			out += '\n';
+		}
+		for (int to = 1; to <= size; to++) {
+			int dest = toInternal[to];
+			if (dest == source) {
+				continue;
+			}
+			//find the path, stored dest first
+			int length = 0;
+			int dist = tableDist(source, dest);
+			bool reachable = hasEdges(source) &&
+				dist != numeric_limits<int>::max();
+			if (reachable) {
+				length = tablePath(source, dest, path);
+				for (int i = 0; i < length; i++) {
+					path[i] = toOriginal[path[i]];
+				}
+			}
+
+			if (format == TEXT_FORMAT) {
+				out += "                             ";
+				appendNumber(out, from);
+				out += "     ";
+				appendNumber(out, to);
+				if (reachable) {
+					out += "     ";
+					appendNumber(out, dist);
+					out += dist < 10 ? "     " : "    ";
+					while (length > 0) {
+						appendNumber(out, path[--length]);
+						out += ' ';
 					}
-					else {
-						cout << "     " << "--" << endl;
+					out += '\n';
+				}
+				//if there is not a path
+				else {
+					out += "     --\n";
+				}
+			}
+			else if (format == CSV_FORMAT) {
+				appendNumber(out, from);
+				out += ',';
+				appendNumber(out, to);
+				out += ',';
+				if (reachable) {
+					appendNumber(out, dist);
+				}
+				out += ',';
+				while (length > 0) {
+					appendNumber(out, path[--length]);
+					if (length > 0) {
+						out += ' ';
 					}
 				}
-				//if there is not a path 
+				out += '\n';
+			}
+			else {
+				out += "{\"from\":";
+				appendNumber(out, from);
+				out += ",\"to\":";
+				appendNumber(out, to);
+				out += ",\"dist\":";
+				if (reachable) {
+					appendNumber(out, dist);
+				}
 				else {
-					cout << "     --" << endl;
+					out += "null";
+				}
+				out += ",\"path\":[";
+				while (length > 0) {
+					appendNumber(out, path[--length]);
+					if (length > 0) {
+						out += ',';
+					}
 				}
+				out += "]}\n";
+			}
+
+			if (out.size() >= blockSize) {
+				os.write(out.data(), out.size());
+				out.clear();
 			}
 		}
 	}
+	os.write(out.data(), out.size());
+	os.flush();
+}
+
+/**
+* appendNumber
+* this function appends the decimal digits of number to out
+* Preconditons: none
+* Postconditions: number is appended to out
+* @param out: buffer to append to
+* @param number: number to be appended
+*/
+void Graph::appendNumber(string& out, int number) {
+	char digits[12];
+	int length = 0;
+	unsigned int rest = number < 0 ? 0u - static_cast<unsigned int>(number) :
+		static_cast<unsigned int>(number);
+	do {
+		digits[length++] = static_cast<char>('0' + rest % 10);
+		rest /= 10;
+	} while (rest != 0);
+	if (number < 0) {
+		out += '-';
+	}
+	while (length > 0) {
+		out += digits[--length];
+	}
 }
 
 /**
@@ -606,17 +1001,2039 @@ void Graph::display(int source, int dest) const {
 		cout << "Invalid destination vertex entered." << endl;
 		return;
 	}
-	cout << source << "  " << dest << "  " << T[source][dest].dist;
-	cout << "    ";
+	cout << source << "  " << dest << "  ";
+	source = toInternal[source];
+	dest = toInternal[dest];
+	if (!reachable(source, dest) ||
+		tableDist(source, dest) == numeric_limits<int>::max()) {
+		cout << "--" << endl;
+		return;
+	}
+	cout << tableDist(source, dest) << "    ";
 	printPath(source, dest);
-	cout << dest << endl;
+	cout << toOriginal[dest] << endl;
 	//now print order of destinations 
 	printDestinations(source, dest);
-	cout << *vertices[dest].data << endl;
+	printName(cout, dest);
+	cout << endl;
+
+}
+
+/**
+* reorderVertices
+* this function relabels the positions of the vertices in the
+* vertices array so that vertices visited close together are
+* stored close together (BFS_ORDER, RCM_ORDER), so that the
+* vertices with the most edges are stored first (DEGREE_ORDER), or
+* back to the order of the file (INPUT_ORDER), vertex numbers used
+* by the other public functions are not changed
+* Preconditions: none
+* Postconditions: vertices are relabeled and findShortestPath must
+* be called again before displaying paths
+* @param order: the ordering to store the vertices in
+*/
+void Graph::reorderVertices(VertexOrder order) {
+	if (size == 0) {
+		return;
+	}
+
+	//count the edges leaving each vertex
+	int degree[MAX_VERTICES] = {};
+	for (int v = 1; v <= size; v++) {
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			degree[v]++;
+		}
+	}
+
+	//sequence[k] is the current position to be moved to position k
+	int sequence[MAX_VERTICES] = {};
+	if (order == INPUT_ORDER) {
+		for (int v = 1; v <= size; v++) {
+			sequence[toOriginal[v]] = v;
+		}
+	}
+	else if (order == DEGREE_ORDER) {
+		for (int v = 1; v <= size; v++) {
+			sequence[v] = v;
+		}
+		stable_sort(sequence + 1, sequence + size + 1,
+			[&degree](int a, int b) { return degree[a] > degree[b]; });
+	}
+	else {
+		//sequence doubles as the queue of the breadth first search
+		bool placed[MAX_VERTICES] = {};
+		int count = 0;
+		while (count < size) {
+			//RCM starts each component at a vertex of lowest degree
+			int start = 0;
+			for (int v = 1; v <= size; v++) {
+				if (!placed[v] && (start == 0 ||
+					(order == RCM_ORDER && degree[v] < degree[start]))) {
+					start = v;
+				}
+			}
+			placed[start] = true;
+			sequence[++count] = start;
+			for (int head = count; head <= count; head++) {
+				int first = count + 1;
+				EdgeIterator e(*this, sequence[head]);
+				while (e.next()) {
+					if (!placed[e.adjVertex]) {
+						placed[e.adjVertex] = true;
+						sequence[++count] = e.adjVertex;
+					}
+				}
+				//RCM visits the neighbors of lowest degree first
+				if (order == RCM_ORDER) {
+					stable_sort(sequence + first, sequence + count + 1,
+						[&degree](int a, int b) { return degree[a] < degree[b]; });
+				}
+			}
+		}
+		if (order == RCM_ORDER) {
+			reverse(sequence + 1, sequence + size + 1);
+		}
+	}
+	relabelVertices(sequence);
+}
+
+/**
+* relabelVertices
+* this function moves the vertices in the vertices array so that
+* the vertex at position sequence[k] is moved to position k and
+* renumbers the EdgeNodes and the vertex number maps to match
+* Precondition: sequence holds each position 1-size exactly once
+* Postcondition: vertices are relabeled and the Table T is reset
+* @param sequence: the new order of the vertex positions
+*/
+void Graph::relabelVertices(const int sequence[]) {
+	//EdgeNodes are renumbered in place
+	bool wasCompressed = compressed;
+	expandEdges();
+
+	int newPosition[MAX_VERTICES] = {};
+	VertexNode relabeled[MAX_VERTICES];
+	int original[MAX_VERTICES] = {};
+	for (int k = 1; k <= size; k++) {
+		newPosition[sequence[k]] = k;
+		relabeled[k] = vertices[sequence[k]];
+		original[k] = toOriginal[sequence[k]];
+	}
+
+	for (int k = 1; k <= size; k++) {
+		vertices[k] = relabeled[k];
+		toOriginal[k] = original[k];
+		toInternal[original[k]] = k;
+		for (EdgeNode* e = vertices[k].edgeHead; e != nullptr; e = e->nextEdge) {
+			e->adjVertex = newPosition[e->adjVertex];
+		}
+	}
+	if (undirected) {
+		homeEdges();
+		indexLowerEdges();
+	}
+
+	//shortest paths are stored by position so they must be recomputed
+	unmapPathCache();
+	resetTable();
+	nextHopRuns.clear();
+	cellCount = 0;
+	overlayEdges.clear();
+	if (reachValid) {
+		buildReachability();
+	}
+
+	if (wasCompressed) {
+		compressEdges();
+	}
+}
+
+/**
+* compressEdges
+* this function replaces the EdgeNodes of every vertex with the
+* compressed adjacency list, which takes a few bytes per edge,
+* the graph can still be searched and displayed, inserting or
+* removing an edge expands the edges back into EdgeNodes
+* Preconditions: none
+* Postconditions: the edges are stored compressed
+*/
+void Graph::compressEdges() {
+	if (compressed) {
+		return;
+	}
+	packedEdges.clear();
+	vector<EdgeNode> edges; // edges of one vertex
+	for (int v = 1; v <= size; v++) {
+		packedStart[v] = static_cast<int>(packedEdges.size());
+
+		//sort edges so that adjVertex can be stored as the gap
+		//from the previous edge
+		edges.clear();
+		for (EdgeNode* e = vertices[v].edgeHead; e != nullptr; e = e->nextEdge) {
+			edges.push_back(*e);
+		}
+		sort(edges.begin(), edges.end(), [](const EdgeNode& a, const EdgeNode& b) {
+			return a.adjVertex < b.adjVertex;
+		});
+		int previous = 0;
+		for (const EdgeNode& edge : edges) {
+			writePacked(packedEdges, edge.adjVertex - previous);
+			writePacked(packedEdges, edge.weight);
+			writePacked(packedEdges, edge.profile + 1);
+			previous = edge.adjVertex;
+		}
+
+		deleteListHelper(vertices[v].edgeHead);
+		vertices[v].edgeHead = nullptr;
+	}
+	packedStart[size + 1] = static_cast<int>(packedEdges.size());
+	packedEdges.shrink_to_fit();
+	compressed = true;
+}
 
+/**
+* expandEdges
+* this function turns the compressed edges back into lists of
+* EdgeNodes so that they can be changed, it is called before
+* any edge is inserted or removed
+* Preconditons: none
+* Postconditions: the edges are stored as EdgeNodes
+*/
+void Graph::expandEdges() {
+	if (!compressed) {
+		return;
+	}
+	for (int v = 1; v <= size; v++) {
+		//append to the tail to keep the edges sorted
+		EdgeNode** tail = &vertices[v].edgeHead;
+		EdgeIterator e(*this, v, true);
+		while (e.next()) {
+			*tail = new EdgeNode();
+			(*tail)->adjVertex = e.adjVertex;
+			(*tail)->weight = e.weight;
+			(*tail)->profile = e.profile;
+			tail = &(*tail)->nextEdge;
+		}
+	}
+	compressed = false;
+	packedEdges.clear();
+	packedEdges.shrink_to_fit();
+}
+
+/**
+* writePacked
+* this function appends number to bytes as a variable byte number
+* Preconditions: number is not negative
+* Postconditions: the encoded number is appended to bytes
+* @param bytes: buffer to append to
+* @param number: number to be encoded
+*/
+void Graph::writePacked(vector<unsigned char>& bytes, int number) {
+	unsigned int rest = static_cast<unsigned int>(number);
+	while (rest >= 0x80) {
+		bytes.push_back(static_cast<unsigned char>(rest | 0x80));
+		rest >>= 7;
+	}
+	bytes.push_back(static_cast<unsigned char>(rest));
+}
+
+/**
+* findNextHops
+* this function finds the shortest paths from every vertex like
+* findShortestPath but only keeps the next vertex on each path,
+* stored as run length encoded rows, without filling Table T,
+* distances are added up from the edges when a route is displayed
+* Preconditons: none
+* Postconditions: the next hop tables are stored
+*/
+void Graph::findNextHops() {
+	nextHopRuns.clear();
+	Table row[MAX_VERTICES];
+	for (int source = 1; source <= size; source++) {
+		nextHopStart[source] = static_cast<int>(nextHopRuns.size());
+
+		//hop[dest] is the vertex after source on the path to dest
+		int hop[MAX_VERTICES] = {};
+		if (hasEdges(source)) {
+			dijkstrasAlgo(source, row);
+			int chain[MAX_VERTICES];
+			for (int dest = 1; dest <= size; dest++) {
+				if (dest == source || hop[dest] != 0 ||
+					row[dest].dist == numeric_limits<int>::max()) {
+					continue;
+				}
+				//walk back until the hop is known or source is next
+				int length = 0;
+				int v = dest;
+				while (hop[v] == 0 && row[v].path != source) {
+					chain[length++] = v;
+					v = row[v].path;
+				}
+				if (hop[v] == 0) {
+					hop[v] = v;
+				}
+				while (length > 0) {
+					hop[chain[--length]] = hop[v];
+				}
+			}
+		}
+
+		//store a run each time the next hop changes
+		for (int dest = 1; dest <= size; dest++) {
+			if (dest == 1 || hop[dest] != hop[dest - 1]) {
+				NextHopRun run;
+				run.firstDest = static_cast<HopVertex>(dest);
+				run.nextHop = static_cast<HopVertex>(hop[dest]);
+				nextHopRuns.push_back(run);
+			}
+		}
+	}
+	nextHopStart[size + 1] = static_cast<int>(nextHopRuns.size());
+	nextHopRuns.shrink_to_fit();
+}
+
+/**
+* nextHop
+* this function looks up the next hop stored by findNextHops
+* for a path from source to dest
+* Preconditons: source and dest are positions of vertices and the
+* next hops have been found
+* Postconditions: returns the position of the vertex after source
+* on the shortest path to dest, or 0 if there is no path
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+*/
+int Graph::nextHop(int source, int dest) const {
+	const NextHopRun* first = nextHopRuns.data() + nextHopStart[source];
+	const NextHopRun* last = nextHopRuns.data() + nextHopStart[source + 1];
+	//find the last run starting at or before dest
+	const NextHopRun* run = upper_bound(first, last, dest,
+		[](int d, const NextHopRun& r) { return d < r.firstDest; });
+	return (run - 1)->nextHop;
 }
 
+/**
+* edgeWeight
+* this function returns the lowest weight of an edge from source
+* to dest, used to recover distances from next hops
+* Preconditons: the edge exists
+* Postconditions: returns the weight of the edge
+* @param source: the source vertex of the edge
+* @param dest: the destination vertex of the edge
+*/
+int Graph::edgeWeight(int source, int dest) const {
+	int weight = numeric_limits<int>::max();
+	EdgeIterator e(*this, source);
+	while (e.next()) {
+		if (e.adjVertex == dest && e.weight < weight) {
+			weight = e.weight;
+		}
+	}
+	return weight;
+}
 
+/**
+* displayRoute
+* this function prints the same information as display by
+* following the next hops stored by findNextHops
+* Precondtion: source and dest must be valid vertices and
+* findNextHops must have been called since the edges last
+* changed, inserting or removing an edge clears the next hops
+* Postcondition: information about the path from
+* source to dest is printed
+* @param source: the source vertex of path to be printed
+* @param dest: the destination vertex of path to be printed
+*/
+void Graph::displayRoute(int source, int dest) const {
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return;
+	}
+	if (!isValidVertex(dest)) {
+		cout << "Invalid destination vertex entered." << endl;
+		return;
+	}
+	if (nextHopRuns.empty()) {
+		cout << "Next hops have not been found." << endl;
+		return;
+	}
+	cout << source << "  " << dest << "  ";
+	int from = toInternal[source];
+	int to = toInternal[dest];
+	if (!reachable(from, to) || (from != to && nextHop(from, to) == 0)) {
+		cout << "--" << endl;
+		return;
+	}
 
+	//follow the next hops to recover the path and its distance,
+	//a path never has more than size vertices
+	int path[MAX_VERTICES];
+	int length = 0;
+	int dist = 0;
+	path[length++] = from;
+	for (int v = from; v != to && length < size; ) {
+		int hop = nextHop(v, to);
+		int weight = hop == 0 ? numeric_limits<int>::max() : edgeWeight(v, hop);
+		//a hop without an edge means there is no path
+		if (weight == numeric_limits<int>::max()) {
+			cout << "--" << endl;
+			return;
+		}
+		dist += weight;
+		path[length++] = hop;
+		v = hop;
+	}
 
+	cout << dist << "    ";
+	for (int i = 0; i < length; i++) {
+		cout << toOriginal[path[i]] << (i + 1 < length ? " " : "");
+	}
+	cout << endl;
+	//now print order of destinations
+	for (int i = 0; i < length; i++) {
+		printName(cout, path[i]);
+		cout << endl;
+	}
+}
 
+/**
+* setPathCache
+* this function sets the file that findShortestPath keeps its
+* results in, if the file holds the results for the same graph
+* findShortestPath maps it instead of running dijkstrasAlgo and
+* rows are read from the file as they are displayed, otherwise
+* the results are computed and written to the file
+* Preconditions: none
+* Postconditions: findShortestPath uses fileName as its cache,
+* an empty fileName turns off the cache
+* @param fileName: path of the cache file
+*/
+void Graph::setPathCache(const string& fileName) {
+	cacheFile = fileName;
+}
+
+/**
+* tableLength
+* this function returns the number of Tables in Table T
+* Preconditons: none
+* Postconditions: returns size * (size + 1) for a directed graph
+* and size * (size - 1) / 2 for an undirected one
+*/
+size_t Graph::tableLength() const {
+	size_t n = static_cast<size_t>(size);
+	return undirected ? n * (n - 1) / 2 : n * (n + 1);
+}
+
+/**
+* tableEntry
+* this function returns the shortest path information from source
+* to dest, from the mapped path cache file if there is one or
+* Table T
+* Preconditons: source and dest are positions in the vertices
+* array, source is before dest in an undirected graph
+* Postconditions: returns the entry of source and dest
+* @param source: the source vertex of the entry
+* @param dest: the destination vertex of the entry
+*/
+const Graph::Table& Graph::tableEntry(int source, int dest) const {
+	const Table* table = cachedRows != nullptr ? cachedRows : T.data();
+	size_t row = static_cast<size_t>(source - 1);
+	if (undirected) {
+		//rows before source hold size - 1, size - 2, ... entries
+		return table[row * size - row * (row + 1) / 2 + (dest - source - 1)];
+	}
+	return table[row * (size + 1) + dest];
+}
+
+/**
+* graphHash
+* this function returns a hash of the vertices and edges (in the
+* order they are stored), the results of findShortestPath only
+* depend on these
+* Preconditons: none
+* Postconditions: returns the hash of the graph
+*/
+unsigned long long Graph::graphHash() const {
+	//64 bit FNV-1a over every number of the graph
+	unsigned long long hash = 14695981039346656037ULL;
+	auto add = [&hash](int number) {
+		for (int byte = 0; byte < 4; byte++) {
+			hash ^= (static_cast<unsigned int>(number) >> (8 * byte)) & 0xff;
+			hash *= 1099511628211ULL;
+		}
+	};
+	add(size);
+	//undirected graphs only keep the upper half of Table T
+	if (undirected) {
+		add(-2);
+	}
+	for (int v = 1; v <= size; v++) {
+		add(toOriginal[v]);
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			add(e.adjVertex);
+			add(e.weight);
+		}
+		//mark the end of the edges of v
+		add(-1);
+	}
+	return hash;
+}
+
+/**
+* mapPathCache
+* this function maps the path cache file into memory if it holds
+* the results for a graph with the given hash
+* Preconditons: cacheFile is set
+* Postconditions: returns true and cachedRows points to the rows
+* if the file is valid, otherwise returns false
+* @param hash: graphHash of the current graph
+*/
+bool Graph::mapPathCache(unsigned long long hash) {
+#ifdef _WIN32
+	return false;
+#else
+	int fd = open(cacheFile.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	size_t length = sizeof(PathCacheHeader) + tableLength() * sizeof(Table);
+	struct stat info;
+	if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != length) {
+		close(fd);
+		return false;
+	}
+	void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+
+	//only the header is read now, rows are paged in when displayed
+	PathCacheHeader expected;
+	expected.hash = hash;
+	expected.size = size;
+	const PathCacheHeader* header = static_cast<const PathCacheHeader*>(mapping);
+	if (memcmp(header->magic, expected.magic, sizeof(expected.magic)) != 0 ||
+		header->hash != expected.hash || header->size != expected.size ||
+		header->tableSize != expected.tableSize) {
+		munmap(mapping, length);
+		return false;
+	}
+	cachedMapping = mapping;
+	cachedLength = length;
+	cachedRows = reinterpret_cast<const Table*>(header + 1);
+	return true;
+#endif
+}
+
+/**
+* writePathCache
+* this function writes Table T to the path cache file
+* Preconditons: cacheFile is set and Table T is filled in
+* Postconditions: the path cache file holds Table T
+* @param hash: graphHash of the current graph
+*/
+void Graph::writePathCache(unsigned long long hash) const {
+	//write to a temporary file and rename it so that no other
+	//process maps a partly written file
+	string tempFile = cacheFile + ".tmp";
+	ofstream outfile(tempFile, ios::binary | ios::trunc);
+	if (!outfile) {
+		cout << "Could not write path cache " << cacheFile << "." << endl;
+		return;
+	}
+	PathCacheHeader header;
+	header.hash = hash;
+	header.size = size;
+	outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	outfile.write(reinterpret_cast<const char*>(T.data()), T.size() * sizeof(Table));
+	outfile.close();
+	if (!outfile || rename(tempFile.c_str(), cacheFile.c_str()) != 0) {
+		cout << "Could not write path cache " << cacheFile << "." << endl;
+		remove(tempFile.c_str());
+	}
+}
+
+/**
+* unmapPathCache
+* this function unmaps the path cache file, it is called whenever
+* the graph changes since the cached rows no longer apply
+* Preconditons: none
+* Postconditions: the file is unmapped and Table T is reset if it
+* was mapped
+*/
+void Graph::unmapPathCache() {
+	if (cachedRows == nullptr) {
+		return;
+	}
+#ifndef _WIN32
+	munmap(const_cast<void*>(cachedMapping), cachedLength);
+#endif
+	cachedMapping = nullptr;
+	cachedLength = 0;
+	cachedRows = nullptr;
+	resetTable();
+}
+
+/**
+* workspace
+* this function returns the SearchSpace of the calling thread
+* Preconditons: none
+* Postconditions: returns the SearchSpace of the calling thread
+*/
+Graph::SearchSpace& Graph::workspace() {
+	static thread_local SearchSpace space;
+	return space;
+}
+
+/**
+* searchPath
+* this function performs dijkstraAlgo from source in space and
+* stops once dest is visited or the distances pass bound, it does
+* not enter the vertices set in blockedVertex and does not follow
+* the edges from spur to the vertices set in blockedNext
+* Preconditons: source is a position in the vertices array
+* Postconditions: returns the distance to dest, or the max int if
+* dest is not reached, space holds the paths of the search
+* @param space: workspace of the search
+* @param source: the source vertex of the search
+* @param dest: the destination vertex, 0 searches every vertex
+* @param blockedVertex: vertices not to enter or nullptr
+* @param spur: the vertex the edges of blockedNext leave
+* @param blockedNext: edges from spur not to follow or nullptr
+* @param bound: the longest distance to search
+*/
+int Graph::searchPath(SearchSpace& space, int source, int dest,
+	const bool blockedVertex[], int spur, const bool blockedNext[],
+	int bound) const {
+	space.start();
+	space.relax(source, 0, 0);
+	for (int v = space.settle(); v != 0; v = space.settle()) {
+		if (space.dist[v] > bound) {
+			break;
+		}
+		if (v == dest) {
+			return space.dist[v];
+		}
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			int w = e.adjVertex;
+			if ((blockedVertex != nullptr && blockedVertex[w]) ||
+				(blockedNext != nullptr && v == spur && blockedNext[w])) {
+				continue;
+			}
+			space.relax(w, space.dist[v] + e.weight, v);
+		}
+	}
+	return numeric_limits<int>::max();
+}
+
+/**
+* tracePath
+* this function returns the positions on the path from source to
+* dest found by a search in space
+* Preconditons: dest was reached by a search from source
+* Postconditions: returns the path from source to dest
+* @param space: workspace of the search
+* @param source: the source vertex of the search
+* @param dest: the destination vertex of the path
+*/
+vector<int> Graph::tracePath(const SearchSpace& space, int source, int dest) {
+	vector<int> path;
+	for (int v = dest; v != source; v = space.path[v]) {
+		path.push_back(v);
+	}
+	path.push_back(source);
+	reverse(path.begin(), path.end());
+	return path;
+}
+
+/**
+* toRoutes
+* this function turns paths of positions into Routes of vertex
+* numbers
+* Preconditons: none
+* Postconditions: returns the Routes
+* @param paths: (distance, positions) of each path
+*/
+vector<Graph::Route> Graph::toRoutes(const vector<pair<int, vector<int>>>& paths) const {
+	vector<Route> routes(paths.size());
+	for (size_t i = 0; i < paths.size(); i++) {
+		routes[i].dist = paths[i].first;
+		for (int v : paths[i].second) {
+			routes[i].path.push_back(toOriginal[v]);
+		}
+	}
+	return routes;
+}
+
+/**
+* findKShortestPaths
+* this function finds the k shortest paths from source to dest that
+* do not visit a vertex twice (Yen's algorithm), each spur search
+* stops at dest or once it can not beat the paths already found
+* Precondtion: source and dest must be valid vertices
+* Postcondition: returns up to k Routes, shortest first
+* @param source: the source vertex of the paths
+* @param dest: the destination vertex of the paths
+* @param k: the number of paths to find
+*/
+vector<Graph::Route> Graph::findKShortestPaths(int source, int dest, int k) const {
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return vector<Route>();
+	}
+	if (!isValidVertex(dest)) {
+		cout << "Invalid destination vertex entered." << endl;
+		return vector<Route>();
+	}
+	int from = toInternal[source];
+	int to = toInternal[dest];
+	if (!reachable(from, to)) {
+		return vector<Route>();
+	}
+	const int noBound = numeric_limits<int>::max();
+	SearchSpace& space = workspace();
+
+	//found paths and candidate paths, as (distance, positions)
+	vector<pair<int, vector<int>>> found;
+	vector<pair<int, vector<int>>> candidates;
+	int dist = searchPath(space, from, to, nullptr, 0, nullptr, noBound);
+	if (k <= 0 || dist == noBound) {
+		return vector<Route>();
+	}
+	found.push_back(make_pair(dist, tracePath(space, from, to)));
+
+	bool blockedVertex[MAX_VERTICES];
+	bool blockedNext[MAX_VERTICES];
+	while (static_cast<int>(found.size()) < k) {
+		const vector<int> previous = found.back().second;
+		int needed = k - static_cast<int>(found.size());
+		int rootDist = 0;
+		//branch off the previous path at each of its vertices
+		for (size_t j = 0; j + 1 < previous.size(); j++) {
+			int spur = previous[j];
+			fill(blockedVertex, blockedVertex + MAX_VERTICES, false);
+			fill(blockedNext, blockedNext + MAX_VERTICES, false);
+			//the spur path may not go back through the root path
+			for (size_t r = 0; r < j; r++) {
+				blockedVertex[previous[r]] = true;
+			}
+			//or leave the root the same way as a found path
+			for (const pair<int, vector<int>>& f : found) {
+				if (f.second.size() > j + 1 &&
+					equal(previous.begin(), previous.begin() + j + 1, f.second.begin())) {
+					blockedNext[f.second[j + 1]] = true;
+				}
+			}
+
+			//a spur path is only kept if it beats the needed candidates
+			int bound = noBound;
+			if (static_cast<int>(candidates.size()) >= needed) {
+				bound = candidates[needed - 1].first - rootDist;
+			}
+			int spurDist = searchPath(space, spur, to, blockedVertex, spur, blockedNext, bound);
+			if (spurDist != noBound) {
+				pair<int, vector<int>> candidate;
+				candidate.first = rootDist + spurDist;
+				candidate.second.assign(previous.begin(), previous.begin() + j);
+				vector<int> spurPath = tracePath(space, spur, to);
+				candidate.second.insert(candidate.second.end(), spurPath.begin(), spurPath.end());
+				if (find(candidates.begin(), candidates.end(), candidate) == candidates.end()) {
+					candidates.insert(upper_bound(candidates.begin(), candidates.end(), candidate),
+						candidate);
+					if (static_cast<int>(candidates.size()) > needed) {
+						candidates.resize(needed);
+					}
+				}
+			}
+			rootDist += edgeWeight(spur, previous[j + 1]);
+		}
+		if (candidates.empty()) {
+			break;
+		}
+		found.push_back(candidates.front());
+		candidates.erase(candidates.begin());
+	}
+	return toRoutes(found);
+}
+
+/**
+* findAlternativeRoutes
+* this function finds the shortest path from source to dest and up
+* to k - 1 alternatives, each the shortest path from source to a
+* via vertex followed by the shortest path from there to dest,
+* found from one search forward from source and one search back
+* from dest, paths that visit a vertex twice are left out
+* Precondtion: source and dest must be valid vertices
+* Postcondition: returns up to k Routes, shortest first
+* @param source: the source vertex of the paths
+* @param dest: the destination vertex of the paths
+* @param k: the number of paths to find
+*/
+vector<Graph::Route> Graph::findAlternativeRoutes(int source, int dest, int k) const {
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return vector<Route>();
+	}
+	if (!isValidVertex(dest)) {
+		cout << "Invalid destination vertex entered." << endl;
+		return vector<Route>();
+	}
+	int from = toInternal[source];
+	int to = toInternal[dest];
+	if (!reachable(from, to)) {
+		return vector<Route>();
+	}
+	const int noBound = numeric_limits<int>::max();
+
+	//forward search from source to every vertex
+	SearchSpace& forward = workspace();
+	searchPath(forward, from, 0, nullptr, 0, nullptr, noBound);
+	if (k <= 0 || forward.distance(to) == noBound) {
+		return vector<Route>();
+	}
+
+	//reverse edges, those entering v are from reverseStart[v]
+	//up to reverseStart[v + 1] as (vertex, weight)
+	vector<int> reverseStart(size + 2, 0);
+	vector<pair<int, int>> reverseEdges;
+	for (int v = 1; v <= size; v++) {
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			reverseStart[e.adjVertex + 1]++;
+		}
+	}
+	for (int v = 1; v <= size + 1; v++) {
+		reverseStart[v] += reverseStart[v - 1];
+	}
+	reverseEdges.resize(reverseStart[size + 1]);
+	vector<int> next(reverseStart.begin(), reverseStart.end());
+	for (int v = 1; v <= size; v++) {
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			reverseEdges[next[e.adjVertex]++] = make_pair(v, e.weight);
+		}
+	}
+
+	//backward search from dest, path[v] is the vertex after v
+	SearchSpace backward;
+	backward.start();
+	backward.relax(to, 0, 0);
+	for (int v = backward.settle(); v != 0; v = backward.settle()) {
+		for (int i = reverseStart[v]; i < reverseStart[v + 1]; i++) {
+			backward.relax(reverseEdges[i].first, backward.dist[v] + reverseEdges[i].second, v);
+		}
+	}
+
+	//every vertex reached both ways is a via vertex, shortest first
+	vector<pair<int, int>> via;
+	for (int v = 1; v <= size; v++) {
+		if (v != from && v != to && forward.distance(v) != noBound &&
+			backward.distance(v) != noBound) {
+			via.push_back(make_pair(forward.dist[v] + backward.dist[v], v));
+		}
+	}
+	sort(via.begin(), via.end());
+
+	vector<pair<int, vector<int>>> routes;
+	routes.push_back(make_pair(forward.dist[to], tracePath(forward, from, to)));
+	bool onPath[MAX_VERTICES];
+	for (size_t i = 0; i < via.size() && static_cast<int>(routes.size()) < k; i++) {
+		pair<int, vector<int>> route;
+		route.first = via[i].first;
+		route.second = tracePath(forward, from, via[i].second);
+		for (int v = backward.path[via[i].second]; v != 0; v = backward.path[v]) {
+			route.second.push_back(v);
+		}
+
+		//skip paths that visit a vertex twice or were already found
+		fill(onPath, onPath + MAX_VERTICES, false);
+		bool simple = true;
+		for (int v : route.second) {
+			simple = simple && !onPath[v];
+			onPath[v] = true;
+		}
+		if (simple && find(routes.begin(), routes.end(), route) == routes.end()) {
+			routes.push_back(route);
+		}
+	}
+	return toRoutes(routes);
+}
+
+/**
+* displayRoutes
+* this function prints the source, dest, distance and path of
+* each Route in routes, one Route per line, or -- for a Route
+* without a path
+* Precondtion: none
+* Postcondition: the routes are printed
+* @param routes: the Routes to be printed
+*/
+void Graph::displayRoutes(const vector<Route>& routes) const {
+	for (const Route& route : routes) {
+		//a Route with no path means there is no path
+		if (route.path.empty()) {
+			cout << "--" << endl;
+			continue;
+		}
+		cout << route.path.front() << "  " << route.path.back() << "  ";
+		cout << route.dist << "    ";
+		for (size_t i = 0; i < route.path.size(); i++) {
+			cout << route.path[i] << (i + 1 < route.path.size() ? " " : "");
+		}
+		cout << endl;
+	}
+}
+
+/**
+* findNearestSources
+* this function searches from all of the sources at once, each
+* starting at its offset (or 0 if there are no offsets), and labels
+* every vertex with its k nearest sources, the distance from each
+* and the previous vertex on the path from each, which replaces a
+* search from every source
+* Precondtion: sources must be valid vertices and offsets must be
+* empty or the same length as sources
+* Postcondition: returns the labels of each vertex number, nearest
+* first, with no labels for vertices no source reaches
+* @param sources: the source vertices
+* @param offsets: the starting distance of each source or empty
+* @param k: the number of sources to find for each vertex
+*/
+vector<vector<Graph::SourceLabel>> Graph::findNearestSources(const vector<int>& sources,
+	const vector<int>& offsets, int k) const {
+	vector<vector<SourceLabel>> labels(size + 1);
+	if (!offsets.empty() && offsets.size() != sources.size()) {
+		cout << "Offsets must be given for every source." << endl;
+		return labels;
+	}
+
+	//queued label (dist, vertex, source, previous vertex) in positions
+	struct Entry {
+		int dist;
+		int vertex;
+		int source;
+		int path;
+	};
+	auto farther = [](const Entry& a, const Entry& b) { return a.dist > b.dist; };
+	vector<Entry> heap;
+	for (size_t i = 0; i < sources.size(); i++) {
+		if (!isValidVertex(sources[i])) {
+			cout << "Invalid source vertex entered." << endl;
+			continue;
+		}
+		Entry entry = { offsets.empty() ? 0 : offsets[i], toInternal[sources[i]],
+			toInternal[sources[i]], 0 };
+		heap.push_back(entry);
+	}
+	make_heap(heap.begin(), heap.end(), farther);
+
+	//labels of each position as they are settled, nearest first
+	vector<vector<SourceLabel>> found(size + 1);
+	auto labeledBy = [&found](int v, int source) {
+		for (const SourceLabel& label : found[v]) {
+			if (label.source == source) {
+				return true;
+			}
+		}
+		return false;
+	};
+	while (!heap.empty()) {
+		pop_heap(heap.begin(), heap.end(), farther);
+		Entry top = heap.back();
+		heap.pop_back();
+		//a vertex keeps the first k sources to reach it
+		if (static_cast<int>(found[top.vertex].size()) >= k || labeledBy(top.vertex, top.source)) {
+			continue;
+		}
+		SourceLabel label;
+		label.source = top.source;
+		label.dist = top.dist;
+		label.path = top.path;
+		found[top.vertex].push_back(label);
+
+		EdgeIterator e(*this, top.vertex);
+		while (e.next()) {
+			if (static_cast<int>(found[e.adjVertex].size()) < k &&
+				!labeledBy(e.adjVertex, top.source)) {
+				Entry next = { top.dist + e.weight, e.adjVertex, top.source, top.vertex };
+				heap.push_back(next);
+				push_heap(heap.begin(), heap.end(), farther);
+			}
+		}
+	}
+
+	//return the labels by vertex number
+	for (int v = 1; v <= size; v++) {
+		for (SourceLabel label : found[v]) {
+			label.source = toOriginal[label.source];
+			label.path = toOriginal[label.path];
+			labels[toOriginal[v]].push_back(label);
+		}
+	}
+	return labels;
+}
+
+/**
+* displayNearestSources
+* this function prints each vertex with its nearest sources, the
+* distance from each and the path from each, one label per line
+* Precondtion: labels was returned by findNearestSources
+* Postcondition: the labels are printed
+* @param labels: the labels of each vertex number
+*/
+void Graph::displayNearestSources(const vector<vector<SourceLabel>>& labels) const {
+	vector<int> path;
+	for (int v = 1; v < static_cast<int>(labels.size()); v++) {
+		if (labels[v].empty()) {
+			cout << v << "  --" << endl;
+		}
+		for (const SourceLabel& label : labels[v]) {
+			//follow the labels of the same source back to it
+			path.clear();
+			for (int u = v; u != 0; ) {
+				path.push_back(u);
+				int previous = 0;
+				for (const SourceLabel& l : labels[u]) {
+					if (l.source == label.source) {
+						previous = l.path;
+					}
+				}
+				u = previous;
+			}
+			cout << v << "  " << label.source << "  " << label.dist << "    ";
+			for (size_t i = path.size(); i > 0; i--) {
+				cout << path[i - 1] << (i > 1 ? " " : "");
+			}
+			cout << endl;
+		}
+	}
+}
+
+/**
+* findWithinDistance
+* this function finds every vertex whose shortest path from source
+* is no longer than radius (the isochrone of source), the search
+* stops once the closest queued vertex is farther than radius and
+* reuses the workspace of the calling thread, so its cost depends
+* on the number of vertices found rather than the size of the graph
+* Precondtion: source must be a valid vertex
+* Postcondition: returns (vertex number, distance) of each vertex
+* found, closest first, starting with source
+* @param source: the source vertex of the search
+* @param radius: the longest distance to search
+*/
+vector<pair<int, int>> Graph::findWithinDistance(int source, int radius) const {
+	vector<pair<int, int>> found;
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return found;
+	}
+	if (radius < 0) {
+		return found;
+	}
+	SearchSpace& space = workspace();
+	space.start();
+	space.relax(toInternal[source], 0, 0);
+	for (int v = space.settle(); v != 0; v = space.settle()) {
+		found.push_back(make_pair(toOriginal[v], space.dist[v]));
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			//only vertices inside the radius are queued
+			if (e.weight <= radius - space.dist[v]) {
+				space.relax(e.adjVertex, space.dist[v] + e.weight, v);
+			}
+		}
+	}
+	return found;
+}
+
+/**
+* insertEdge
+* this function inserts an edge from source to dest, or updates
+* it if it already exists, whose travel time depends on the time
+* it is entered, the weight of the edge is its lowest travel time,
+* the breakpoints of the old profile are reused if it has as many
+* Precondtions: valid source and dest must be entered
+* Postconditions: edge is inserted with the profile if the
+* breakpoints are in order of departure time, no travel time is
+* negative and no later departure arrives earlier (FIFO)
+* @param source: the source vertex
+* @param dest: the destination vertex
+* @param profile: (departure time, travel time) breakpoints
+*/
+void Graph::insertEdge(int source, int dest, const vector<pair<int, int>>& profile) {
+	if (profile.empty()) {
+		cout << "Travel time profile has no breakpoints." << endl;
+		return;
+	}
+	int weight = profile[0].second;
+	for (size_t i = 0; i < profile.size(); i++) {
+		if (profile[i].second < 0) {
+			cout << "Weight can not be negative." << endl;
+			return;
+		}
+		//travel time may not fall faster than time passes, so
+		//leaving later never arrives earlier
+		if (i > 0 && (profile[i].first <= profile[i - 1].first ||
+			profile[i].second - profile[i - 1].second < profile[i - 1].first - profile[i].first)) {
+			cout << "Travel time profile is not FIFO." << endl;
+			return;
+		}
+		weight = min(weight, profile[i].second);
+	}
+
+	//take the old profile off the edge before insertEdge releases
+	//it if its breakpoints can be overwritten
+	int slot = -1;
+	if (isValidVertex(source) && isValidVertex(dest)) {
+		expandEdges();
+		EdgeNode* edge = findEdge(toInternal[source], toInternal[dest]);
+		if (edge != nullptr && edge->profile >= 0 &&
+			profileStart[edge->profile + 1] - profileStart[edge->profile] ==
+			static_cast<int>(profile.size())) {
+			slot = edge->profile;
+			edge->profile = -1;
+		}
+	}
+	insertEdge(source, dest, weight);
+	if (!isValidVertex(source) || !isValidVertex(dest)) {
+		return;
+	}
+
+	EdgeNode* edge = findEdge(toInternal[source], toInternal[dest]);
+	if (slot >= 0) {
+		copy(profile.begin(), profile.end(), profilePoints.begin() + profileStart[slot]);
+	}
+	else {
+		slot = static_cast<int>(profileStart.size()) - 1;
+		profilePoints.insert(profilePoints.end(), profile.begin(), profile.end());
+		profileStart.push_back(static_cast<int>(profilePoints.size()));
+	}
+	edge->profile = slot;
+	if (undirected && !loading) {
+		updateLowerEdges(min(toInternal[source], toInternal[dest]),
+			max(toInternal[source], toInternal[dest]));
+	}
+}
+
+/**
+* travelTime
+* this function returns the travel time of an edge leaving at
+* time departure by interpolating between the breakpoints of its
+* profile
+* Preconditons: none
+* Postconditions: returns the travel time of the edge
+* @param weight: the weight of the edge, used if it has no profile
+* @param profile: the profile of the edge or -1
+* @param departure: the time the edge is entered
+*/
+int Graph::travelTime(int weight, int profile, int departure) const {
+	if (profile < 0) {
+		return weight;
+	}
+	const pair<int, int>* first = profilePoints.data() + profileStart[profile];
+	const pair<int, int>* last = profilePoints.data() + profileStart[profile + 1];
+	//find the first breakpoint after departure
+	const pair<int, int>* after = upper_bound(first, last, departure,
+		[](int t, const pair<int, int>& point) { return t < point.first; });
+	if (after == first) {
+		return first->second;
+	}
+	if (after == last) {
+		return (last - 1)->second;
+	}
+	const pair<int, int>* before = after - 1;
+	long long change = static_cast<long long>(after->second - before->second) *
+		(departure - before->first) / (after->first - before->first);
+	return before->second + static_cast<int>(change);
+}
+
+/**
+* releaseProfile
+* this function removes the travel time profile of edge, its
+* breakpoints stay in profilePoints until more than half of them
+* are unused and the profiles are compacted
+* Preconditons: the edges are stored as EdgeNodes
+* Postconditions: edge has no profile
+* @param edge: the edge to remove the profile of
+*/
+void Graph::releaseProfile(EdgeNode* edge) {
+	if (edge->profile < 0) {
+		return;
+	}
+	unusedPoints += profileStart[edge->profile + 1] - profileStart[edge->profile];
+	edge->profile = -1;
+	if (unusedPoints * 2 > static_cast<int>(profilePoints.size())) {
+		compactProfiles();
+	}
+}
+
+/**
+* compactProfiles
+* this function moves the profiles that edges still use to the
+* front of profilePoints and renumbers them
+* Preconditons: the edges are stored as EdgeNodes
+* Postconditions: profilePoints only holds profiles in use
+*/
+void Graph::compactProfiles() {
+	vector<int> start(1, 0);
+	vector<pair<int, int>> points;
+	for (int v = 1; v <= size; v++) {
+		for (EdgeNode* e = vertices[v].edgeHead; e != nullptr; e = e->nextEdge) {
+			if (e->profile >= 0) {
+				points.insert(points.end(), profilePoints.begin() + profileStart[e->profile],
+					profilePoints.begin() + profileStart[e->profile + 1]);
+				e->profile = static_cast<int>(start.size()) - 1;
+				start.push_back(static_cast<int>(points.size()));
+			}
+		}
+	}
+	profileStart.swap(start);
+	profilePoints.swap(points);
+	unusedPoints = 0;
+	//the lower edges copy the profile numbers
+	if (undirected) {
+		indexLowerEdges();
+	}
+}
+
+/**
+* findEarliestArrival
+* this function finds the path from source to dest that arrives
+* first when leaving source at time departure, using the travel
+* time profiles of the edges at the time each edge is entered
+* Precondtion: source and dest must be valid vertices
+* Postcondition: returns the Route with dist as the travel time,
+* the path is empty if dest can not be reached
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+* @param departure: the time of leaving source
+*/
+Graph::Route Graph::findEarliestArrival(int source, int dest, int departure) const {
+	Route route;
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return route;
+	}
+	if (!isValidVertex(dest)) {
+		cout << "Invalid destination vertex entered." << endl;
+		return route;
+	}
+	int from = toInternal[source];
+	int to = toInternal[dest];
+	if (!reachable(from, to)) {
+		return route;
+	}
+
+	//dist in space is the time of arriving at each vertex, since
+	//the profiles are FIFO the first arrival is settled first
+	SearchSpace& space = workspace();
+	space.start();
+	space.relax(from, departure, 0);
+	for (int v = space.settle(); v != 0; v = space.settle()) {
+		if (v == to) {
+			route.dist = space.dist[v] - departure;
+			for (int p : tracePath(space, from, to)) {
+				route.path.push_back(toOriginal[p]);
+			}
+			break;
+		}
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			space.relax(e.adjVertex, space.dist[v] + travelTime(e.weight, e.profile, space.dist[v]), v);
+		}
+	}
+	return route;
+}
+
+/**
+* partitionGraph
+* this function splits the vertices into cells of up to cellSize
+* vertices grown breadth first so that few edges join cells, then
+* finds the overlay edges between the boundary vertices of each cell,
+* inserting or removing an edge customizes only the cells of its
+* vertices again
+* Preconditions: none
+* Postconditions: the graph is partitioned and the overlay is found,
+* reorderVertices removes the partition
+* @param cellSize: the most vertices of a cell
+*/
+void Graph::partitionGraph(int cellSize) {
+	if (cellSize < 1) {
+		cout << "Cell size must be positive." << endl;
+		return;
+	}
+
+	//cells grow along edges in either direction
+	vector<vector<int>> neighbors(size + 1);
+	for (int v = 1; v <= size; v++) {
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			neighbors[v].push_back(e.adjVertex);
+			neighbors[e.adjVertex].push_back(v);
+		}
+	}
+
+	cellCount = 0;
+	fill(cellOf, cellOf + MAX_VERTICES, -1);
+	int queue[MAX_VERTICES];
+	for (int seed = 1; seed <= size; seed++) {
+		if (cellOf[seed] != -1) {
+			continue;
+		}
+		int cell = cellCount++;
+		int head = 0;
+		int tail = 0;
+		cellOf[seed] = cell;
+		queue[tail++] = seed;
+		while (head < tail && tail < cellSize) {
+			for (int w : neighbors[queue[head++]]) {
+				if (cellOf[w] == -1 && tail < cellSize) {
+					cellOf[w] = cell;
+					queue[tail++] = w;
+				}
+			}
+		}
+	}
+
+	findBoundary();
+	overlayEdges.assign(size + 1, vector<pair<int, int>>());
+	for (int cell = 0; cell < cellCount; cell++) {
+		customizeCell(cell);
+	}
+}
+
+/**
+* findBoundary
+* this function finds the boundary vertices of the cells
+* Preconditons: the graph has been partitioned
+* Postconditions: boundary is set for every vertex
+*/
+void Graph::findBoundary() {
+	fill(boundary, boundary + MAX_VERTICES, false);
+	for (int v = 1; v <= size; v++) {
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			if (cellOf[v] != cellOf[e.adjVertex]) {
+				boundary[v] = true;
+				boundary[e.adjVertex] = true;
+			}
+		}
+	}
+}
+
+/**
+* cellMask
+* this function sets outside[v] for every vertex v not in cell
+* Preconditons: the graph has been partitioned
+* Postconditions: outside marks the vertices not in cell
+* @param cell: the cell to keep
+* @param outside: array of MAX_VERTICES to be set
+*/
+void Graph::cellMask(int cell, bool outside[]) const {
+	for (int v = 0; v < MAX_VERTICES; v++) {
+		outside[v] = v < 1 || v > size || cellOf[v] != cell;
+	}
+}
+
+/**
+* customizeCell
+* this function finds the overlay edges between the boundary
+* vertices of cell with a search inside the cell from each of them,
+* only the cell is searched so a change of weight inside a cell
+* only needs the cell to be customized again
+* Preconditons: the graph has been partitioned
+* Postconditions: the overlay edges of cell are found
+* @param cell: the cell to customize
+*/
+void Graph::customizeCell(int cell) {
+	bool outside[MAX_VERTICES];
+	cellMask(cell, outside);
+	SearchSpace& space = workspace();
+	for (int b = 1; b <= size; b++) {
+		if (cellOf[b] != cell) {
+			continue;
+		}
+		overlayEdges[b].clear();
+		if (!boundary[b]) {
+			continue;
+		}
+		searchPath(space, b, 0, outside, 0, nullptr, numeric_limits<int>::max());
+		for (int other = 1; other <= size; other++) {
+			if (other != b && !outside[other] && boundary[other] &&
+				space.distance(other) != numeric_limits<int>::max()) {
+				overlayEdges[b].push_back(make_pair(other, space.dist[other]));
+			}
+		}
+	}
+}
+
+/**
+* updateOverlay
+* this function updates the cells of source and dest after the
+* edge between them was inserted or removed
+* Preconditons: none
+* Postconditions: the overlay matches the edges if the graph has
+* been partitioned
+* @param source: the source vertex of the edge
+* @param dest: the destination vertex of the edge
+*/
+void Graph::updateOverlay(int source, int dest) {
+	if (cellCount == 0) {
+		return;
+	}
+	//only the cells of source and dest can have gained or lost
+	//boundary vertices or paths
+	findBoundary();
+	customizeCell(cellOf[source]);
+	if (cellOf[dest] != cellOf[source]) {
+		customizeCell(cellOf[dest]);
+	}
+}
+
+/**
+* findOverlayPath
+* this function finds the shortest path from source to dest by
+* searching the edges of the cells of source and dest and only the
+* overlay edges of every other cell, overlay edges on the path are
+* then expanded by a search inside their cell
+* Precondtion: source and dest must be valid vertices and the
+* graph must be partitioned
+* Postcondition: returns the Route, the path is empty if dest can
+* not be reached
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+*/
+Graph::Route Graph::findOverlayPath(int source, int dest) const {
+	Route route;
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return route;
+	}
+	if (!isValidVertex(dest)) {
+		cout << "Invalid destination vertex entered." << endl;
+		return route;
+	}
+	if (cellCount == 0) {
+		cout << "Graph has not been partitioned." << endl;
+		return route;
+	}
+	int from = toInternal[source];
+	int to = toInternal[dest];
+	if (!reachable(from, to)) {
+		return route;
+	}
+	int sourceCell = cellOf[from];
+	int destCell = cellOf[to];
+
+	SearchSpace& space = workspace();
+	space.start();
+	space.relax(from, 0, 0);
+	for (int v = space.settle(); v != 0 && v != to; v = space.settle()) {
+		//other cells are crossed by their overlay edges, only edges
+		//leaving the cell are followed there
+		bool local = cellOf[v] == sourceCell || cellOf[v] == destCell;
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			if (local || cellOf[e.adjVertex] != cellOf[v]) {
+				space.relax(e.adjVertex, space.dist[v] + e.weight, v);
+			}
+		}
+		if (!local) {
+			for (const pair<int, int>& edge : overlayEdges[v]) {
+				space.relax(edge.first, space.dist[v] + edge.second, v);
+			}
+		}
+	}
+	if (space.distance(to) == numeric_limits<int>::max()) {
+		return route;
+	}
+	route.dist = space.dist[to];
+	vector<int> coarse = tracePath(space, from, to);
+
+	//expand the overlay edges, which join two vertices of a cell
+	//other than the cells of source and dest
+	vector<int> path(1, from);
+	bool outside[MAX_VERTICES];
+	for (size_t i = 1; i < coarse.size(); i++) {
+		int u = coarse[i - 1];
+		int v = coarse[i];
+		if (cellOf[u] == cellOf[v] && cellOf[u] != sourceCell && cellOf[u] != destCell) {
+			cellMask(cellOf[u], outside);
+			searchPath(space, u, v, outside, 0, nullptr, numeric_limits<int>::max());
+			vector<int> inside = tracePath(space, u, v);
+			path.insert(path.end(), inside.begin() + 1, inside.end());
+		}
+		else {
+			path.push_back(v);
+		}
+	}
+	for (int v : path) {
+		route.path.push_back(toOriginal[v]);
+	}
+	return route;
+}
+
+/**
+* findRoutes
+* this function finds the shortest path from source to each of
+* dests with one search that stops once every dest is visited, it
+* only uses the workspace of the calling thread so it may be called
+* by several threads at once while the graph is not changed
+* Precondtion: source and dests must be valid vertices
+* Postcondition: returns the Route to each of dests in order, the
+* path is empty if the dest can not be reached
+* @param source: the source vertex of the paths
+* @param dests: the destination vertices of the paths
+*/
+vector<Graph::Route> Graph::findRoutes(int source, const vector<int>& dests) const {
+	vector<Route> routes(dests.size());
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return routes;
+	}
+	int from = toInternal[source];
+
+	//count the different destinations still to be visited
+	bool wanted[MAX_VERTICES] = {};
+	int remaining = 0;
+	for (int dest : dests) {
+		if (!isValidVertex(dest)) {
+			cout << "Invalid destination vertex entered." << endl;
+		}
+		else if (!wanted[toInternal[dest]] && reachable(from, toInternal[dest])) {
+			wanted[toInternal[dest]] = true;
+			remaining++;
+		}
+	}
+
+	SearchSpace& space = workspace();
+	space.start();
+	space.relax(from, 0, 0);
+	for (int v = space.settle(); v != 0 && remaining > 0; v = space.settle()) {
+		if (wanted[v]) {
+			remaining--;
+		}
+		EdgeIterator e(*this, v);
+		while (e.next()) {
+			space.relax(e.adjVertex, space.dist[v] + e.weight, v);
+		}
+	}
+
+	for (size_t i = 0; i < dests.size(); i++) {
+		if (!isValidVertex(dests[i])) {
+			continue;
+		}
+		int to = toInternal[dests[i]];
+		if (space.distance(to) != numeric_limits<int>::max() && space.visited[to]) {
+			routes[i].dist = space.dist[to];
+			for (int v : tracePath(space, from, to)) {
+				routes[i].path.push_back(toOriginal[v]);
+			}
+		}
+	}
+	return routes;
+}
+
+/**
+* buildReachability
+* this function finds the strongly connected components of the
+* graph (Tarjan's algorithm without recursion) and which components
+* each component reaches, after which searches and display return
+* right away when there is no path, insertEdge and removeEdge keep
+* the index up to date once it is built, findShortestPath builds it
+* Preconditions: none
+* Postconditions: the reachability index is built
+*/
+void Graph::buildReachability() {
+	//order[v] is when v was found (0 if not yet), low[v] the earliest
+	//vertex still on the stack that v reaches
+	int order[MAX_VERTICES] = {};
+	int low[MAX_VERTICES] = {};
+	bool onStack[MAX_VERTICES] = {};
+	int stack[MAX_VERTICES];
+	int top = 0;
+	int found = 0;
+	int components = 0;
+
+	//each frame is a vertex and the position in its edges
+	struct Frame {
+		int vertex;
+		EdgeIterator edge;
+	};
+	vector<Frame> frames;
+	for (int root = 1; root <= size; root++) {
+		if (order[root] != 0) {
+			continue;
+		}
+		order[root] = low[root] = ++found;
+		stack[top++] = root;
+		onStack[root] = true;
+		frames.push_back(Frame{ root, EdgeIterator(*this, root) });
+		while (!frames.empty()) {
+			int v = frames.back().vertex;
+			if (frames.back().edge.next()) {
+				int w = frames.back().edge.adjVertex;
+				if (order[w] == 0) {
+					order[w] = low[w] = ++found;
+					stack[top++] = w;
+					onStack[w] = true;
+					frames.push_back(Frame{ w, EdgeIterator(*this, w) });
+				}
+				else if (onStack[w]) {
+					low[v] = min(low[v], order[w]);
+				}
+				continue;
+			}
+
+			//all edges of v are done, v may be the root of a component
+			frames.pop_back();
+			if (low[v] == order[v]) {
+				int w;
+				do {
+					w = stack[--top];
+					onStack[w] = false;
+					component[w] = components;
+				} while (w != v);
+				components++;
+			}
+			if (!frames.empty()) {
+				int parent = frames.back().vertex;
+				low[parent] = min(low[parent], low[v]);
+			}
+		}
+	}
+
+	//Tarjan finds a component after every component it reaches, so
+	//each component only needs the components found before it
+	vector<vector<int>> members(components);
+	for (int v = 1; v <= size; v++) {
+		members[component[v]].push_back(v);
+	}
+	reaches.assign(components, bitset<MAX_VERTICES>());
+	for (int c = 0; c < components; c++) {
+		reaches[c].set(c);
+		for (int v : members[c]) {
+			EdgeIterator e(*this, v);
+			while (e.next()) {
+				reaches[c] |= reaches[component[e.adjVertex]];
+			}
+		}
+		reachCount[c] = 0;
+		for (int c2 = 0; c2 <= c; c2++) {
+			if (reaches[c].test(c2)) {
+				reachCount[c] += static_cast<int>(members[c2].size());
+			}
+		}
+	}
+	reachValid = true;
+}
+
+/**
+* canReach
+* this function returns if there is a path from source to dest,
+* from the reachability index if it is built or a search if not
+* Precondtion: source and dest must be valid vertices
+* Postcondition: returns true if there is a path
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+*/
+bool Graph::canReach(int source, int dest) const {
+	if (!isValidVertex(source)) {
+		cout << "Invalid source vertex entered." << endl;
+		return false;
+	}
+	if (!isValidVertex(dest)) {
+		cout << "Invalid destination vertex entered." << endl;
+		return false;
+	}
+	int from = toInternal[source];
+	int to = toInternal[dest];
+	if (reachValid) {
+		return reachable(from, to);
+	}
+	return searchPath(workspace(), from, to, nullptr, 0, nullptr,
+		numeric_limits<int>::max()) != numeric_limits<int>::max();
+}
+
+/**
+* findVertex
+* this function looks up a vertex by its description in the hash
+* index of the descriptions
+* Precondtion: none
+* Postcondition: returns the vertex number of the first vertex with
+* the description name, or 0 if there is none
+* @param name: the description of the vertex
+*/
+int Graph::findVertex(const string& name) const {
+	unsigned int slot = hashName(name.data(), name.size()) & (NAME_SLOTS - 1);
+	for (; nameIndex[slot] != 0; slot = (slot + 1) & (NAME_SLOTS - 1)) {
+		const VertexNode& node = vertices[toInternal[nameIndex[slot]]];
+		if (name.size() == static_cast<size_t>(node.nameLength) &&
+			namePool.compare(node.nameStart, node.nameLength, name) == 0) {
+			return nameIndex[slot];
+		}
+	}
+	return 0;
+}
+
+/**
+* display
+* this function does the same as display for the vertices with the
+* descriptions source and dest
+* Precondtion: source and dest must be descriptions of vertices
+* Postcondition: information about the path from
+* source to dest is printed
+* @param source: the description of the source vertex
+* @param dest: the description of the destination vertex
+*/
+void Graph::display(const string& source, const string& dest) const {
+	display(findVertex(source), findVertex(dest));
+}
+
+/**
+* homeEdges
+* this function moves every EdgeNode of an undirected graph to
+* the lower of its two positions, if the edge is already stored
+* there the one from the lower vertex number is kept
+* Precondition: the edges are stored as EdgeNodes
+* Postcondition: no EdgeNode leads to a lower position
+*/
+void Graph::homeEdges() {
+	for (int v = 1; v <= size; v++) {
+		EdgeNode* prev = nullptr;
+		EdgeNode* curr = vertices[v].edgeHead;
+		while (curr != nullptr) {
+			EdgeNode* next = curr->nextEdge;
+			int lower = curr->adjVertex;
+			if (lower >= v) {
+				prev = curr;
+				curr = next;
+				continue;
+			}
+			//unlink curr from the list of v
+			if (prev == nullptr) {
+				vertices[v].edgeHead = next;
+			}
+			else {
+				prev->nextEdge = next;
+			}
+			EdgeNode* stored = findEdge(lower, v);
+			if (stored == nullptr) {
+				curr->adjVertex = v;
+				curr->nextEdge = vertices[lower].edgeHead;
+				vertices[lower].edgeHead = curr;
+			}
+			else {
+				if (toOriginal[v] < toOriginal[lower]) {
+					stored->weight = curr->weight;
+					swap(stored->profile, curr->profile);
+				}
+				releaseProfile(curr);
+				delete curr;
+			}
+			curr = next;
+		}
+	}
+}
+
+/**
+* indexLowerEdges
+* this function copies the edges of an undirected graph to the
+* lowerEdges of their higher position, it is called when many
+* edges change at once
+* Preconditons: none
+* Postconditions: lowerEdges matches the stored edges, and is
+* empty if the graph is directed
+*/
+void Graph::indexLowerEdges() {
+	lowerEdges.clear();
+	fill(lowerStart, lowerStart + MAX_VERTICES + 1, 0);
+	if (!undirected) {
+		return;
+	}
+
+	//lower[v] is the edges to v from lower positions, in order of
+	//their position since the positions are walked in order
+	vector<vector<EdgeNode>> lower(size + 1);
+	for (int v = 1; v <= size; v++) {
+		EdgeIterator e(*this, v, true);
+		while (e.next()) {
+			if (e.adjVertex > v) {
+				EdgeNode edge;
+				edge.adjVertex = v;
+				edge.weight = e.weight;
+				edge.profile = e.profile;
+				lower[e.adjVertex].push_back(edge);
+			}
+		}
+	}
+	for (int v = 1; v <= size; v++) {
+		lowerStart[v] = static_cast<int>(lowerEdges.size());
+		int previous = 0;
+		for (const EdgeNode& edge : lower[v]) {
+			writePacked(lowerEdges, edge.adjVertex - previous);
+			writePacked(lowerEdges, edge.weight);
+			writePacked(lowerEdges, edge.profile + 1);
+			previous = edge.adjVertex;
+		}
+	}
+	lowerStart[size + 1] = static_cast<int>(lowerEdges.size());
+	lowerEdges.shrink_to_fit();
+}
+
+/**
+* updateLowerEdges
+* this function rewrites the edge from source in the lowerEdges of
+* dest after that one edge was inserted, changed or removed, only
+* the edges of dest are encoded again
+* Preconditons: the graph is undirected, source is the lower
+* position and the edges are stored as EdgeNodes
+* Postconditions: lowerEdges matches the stored edges
+* @param source: the lower position of the edge
+* @param dest: the higher position of the edge
+*/
+void Graph::updateLowerEdges(int source, int dest) {
+	//an edge from a vertex to itself has no lower copy
+	if (source == dest) {
+		return;
+	}
+
+	//decode the edges of dest without the old edge from source
+	vector<EdgeNode> edges;
+	const unsigned char* pos = lowerEdges.data() + lowerStart[dest];
+	const unsigned char* end = lowerEdges.data() + lowerStart[dest + 1];
+	int adjVertex = 0;
+	while (pos != end) {
+		EdgeNode edge;
+		adjVertex += readPacked(pos);
+		edge.adjVertex = adjVertex;
+		edge.weight = readPacked(pos);
+		edge.profile = readPacked(pos) - 1;
+		if (adjVertex != source) {
+			edges.push_back(edge);
+		}
+	}
+	EdgeNode* stored = findEdge(source, dest);
+	if (stored != nullptr) {
+		EdgeNode edge;
+		edge.adjVertex = source;
+		edge.weight = stored->weight;
+		edge.profile = stored->profile;
+		edges.insert(lower_bound(edges.begin(), edges.end(), edge,
+			[](const EdgeNode& a, const EdgeNode& b) { return a.adjVertex < b.adjVertex; }), edge);
+	}
+
+	//replace the old bytes of dest and move the later starts
+	vector<unsigned char> bytes;
+	int previous = 0;
+	for (const EdgeNode& edge : edges) {
+		writePacked(bytes, edge.adjVertex - previous);
+		writePacked(bytes, edge.weight);
+		writePacked(bytes, edge.profile + 1);
+		previous = edge.adjVertex;
+	}
+	int change = static_cast<int>(bytes.size()) - (lowerStart[dest + 1] - lowerStart[dest]);
+	lowerEdges.erase(lowerEdges.begin() + lowerStart[dest], lowerEdges.begin() + lowerStart[dest + 1]);
+	lowerEdges.insert(lowerEdges.begin() + lowerStart[dest], bytes.begin(), bytes.end());
+	for (int v = dest + 1; v <= size + 1; v++) {
+		lowerStart[v] += change;
+	}
+}
+
+/**
+* tableDist
+* this function returns the shortest distance from source to dest
+* found by findShortestPath, undirected graphs only store the
+* entries with source before dest
+* Preconditons: source and dest are positions of vertices
+* Postconditions: returns the distance, the max int if no path
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+*/
+int Graph::tableDist(int source, int dest) const {
+	//no table before findShortestPath
+	if (cachedRows == nullptr && T.empty()) {
+		return numeric_limits<int>::max();
+	}
+	if (undirected) {
+		if (source == dest) {
+			return 0;
+		}
+		if (dest < source) {
+			swap(source, dest);
+		}
+	}
+	return tableEntry(source, dest).dist;
+}
+
+/**
+* tablePath
+* this function stores the shortest path from source to dest
+* found by findShortestPath in path, dest first, in undirected
+* graphs the path from a later source is the reverse of the path
+* in the row of dest
+* Preconditons: source and dest are positions of vertices, path
+* has room for size + 1 positions
+* Postconditions: returns the number of vertices on the path, 0 if
+* there is no path
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+* @param path: positions of the path, dest first
+*/
+int Graph::tablePath(int source, int dest, int path[]) const {
+	if (tableDist(source, dest) == numeric_limits<int>::max()) {
+		return 0;
+	}
+	//a path never has more than size vertices
+	int length = 0;
+	if (!undirected) {
+		for (int v = dest; v != source && length < size; v = tableEntry(source, v).path) {
+			path[length++] = v;
+		}
+		path[length++] = source;
+		return length;
+	}
+
+	//walk back from the higher vertex in the row of the lower one
+	int lower = min(source, dest);
+	int v = max(source, dest);
+	while (v > lower && length < size) {
+		path[length++] = v;
+		v = tableEntry(lower, v).path;
+	}
+	if (v == lower) {
+		path[length++] = lower;
+		//the walk gives the path dest first if source is the lower
+		if (source != lower) {
+			reverse(path, path + length);
+		}
+		return length;
+	}
+
+	//the path passes a vertex before lower, the rows of the lower
+	//vertices it passes give the rest
+	vector<int> forward(1, source);
+	appendTablePath(source, dest, forward);
+	//edges of weight 0 can make the rows disagree on the vertices of
+	//a path, the loops this leaves add nothing to its length
+	length = 0;
+	for (int vertex : forward) {
+		int seen = 0;
+		while (seen < length && path[seen] != vertex) {
+			seen++;
+		}
+		if (seen < length) {
+			length = seen;
+		}
+		path[length++] = vertex;
+	}
+	reverse(path, path + length);
+	return length;
+}
+
+/**
+* appendTablePath
+* this function appends the shortest path from source to dest in
+* an undirected graph to path, the row of the lower of the two
+* only holds the vertices after it so where the path passes a
+* vertex x before it the part up to x is the reverse of the path
+* in the row of x
+* Preconditons: the graph is undirected and dest is reachable
+* from source
+* Postconditions: the path after source, ending with dest, is
+* appended to path
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+* @param path: positions of the path, source first
+*/
+void Graph::appendTablePath(int source, int dest, vector<int>& path) const {
+	if (source > dest) {
+		//the reverse of the path from dest, which is read from a
+		//lower row
+		vector<int> backward(1, dest);
+		appendTablePath(dest, source, backward);
+		path.insert(path.end(), backward.rbegin() + 1, backward.rend());
+		return;
+	}
+	//walk back from dest in the row of source until source or a
+	//vertex before it
+	vector<int> walk;
+	int v = dest;
+	while (v > source) {
+		walk.push_back(v);
+		v = tableEntry(source, v).path;
+	}
+	if (v != source) {
+		appendTablePath(source, v, path);
+	}
+	path.insert(path.end(), walk.rbegin(), walk.rend());
+}
+
+/**
+* setUndirected
+* this function sets whether the edges are undirected, each
+* undirected edge is stored once and can be used both ways, the
+* edges already in the graph are converted, two directions of
+* the same pair become one edge with the weight of the one from
+* the lower vertex number, Table T only keeps the entries with
+* source before dest and the other half is read from them
+* Preconditions: none
+* Postconditions: the graph is undirected if isUndirected is true
+* and findShortestPath must be called again before displaying paths
+* @param isUndirected: whether the edges are undirected
+*/
+void Graph::setUndirected(bool isUndirected) {
+	if (undirected == isUndirected) {
+		return;
+	}
+	//EdgeNodes are moved between the vertices
+	bool wasCompressed = compressed;
+	expandEdges();
+	undirected = isUndirected;
+
+	if (undirected) {
+		homeEdges();
+	}
+	else {
+		//give every edge a copy in the other direction
+		for (int v = 1; v <= size; v++) {
+			for (EdgeNode* e = vertices[v].edgeHead; e != nullptr; e = e->nextEdge) {
+				if (e->adjVertex > v) {
+					EdgeNode* reverseEdge = new EdgeNode();
+					reverseEdge->adjVertex = v;
+					reverseEdge->weight = e->weight;
+					//each edge has its own copy of the profile
+					if (e->profile >= 0) {
+						reverseEdge->profile = static_cast<int>(profileStart.size()) - 1;
+						for (int p = profileStart[e->profile]; p < profileStart[e->profile + 1]; p++) {
+							profilePoints.push_back(profilePoints[p]);
+						}
+						profileStart.push_back(static_cast<int>(profilePoints.size()));
+					}
+					reverseEdge->nextEdge = vertices[e->adjVertex].edgeHead;
+					vertices[e->adjVertex].edgeHead = reverseEdge;
+				}
+			}
+		}
+	}
+	indexLowerEdges();
+
+	//shortest paths are stored differently so they must be recomputed
+	unmapPathCache();
+	resetTable();
+	nextHopRuns.clear();
+	cellCount = 0;
+	overlayEdges.clear();
+	if (reachValid) {
+		buildReachability();
+	}
+
+	if (wasCompressed) {
+		compressEdges();
+	}
+}
@@ -14,11 +14,36 @@
  * -assignment operator
  * -findShortesPath computes all shortest paths betweeen all
  * vertices and stores them
- * -displayAll prints out all of the graphs information
+ * -displayAll prints out all of the graphs information, as text,
+ * CSV or JSON lines, to any output stream
  * -display prints out path information between two vertices
+ * -reorderVertices relabels the vertices for memory locality while
+ * all public functions keep using the vertex numbers from the file
+ * -compressEdges stores the edges in a compact read only form
+ * -findNextHops stores all shortest paths as compressed next hop tables
+ * -setPathCache keeps the results of findShortestPath in a file so
+ * later runs on the same graph map them instead of recomputing them
+ * -findKShortestPaths and findAlternativeRoutes find several paths
+ * between two vertices
+ * -findNearestSources finds the nearest of many sources to every
+ * vertex in one search
+ * -findWithinDistance finds every vertex within a distance of a source
+ * -edges may have travel time profiles that depend on the time of
+ * departure, findEarliestArrival searches by the time of arrival
+ * -partitionGraph splits the graph into cells and builds an overlay
+ * of the cells that findOverlayPath searches
+ * -findRoutes answers several destinations from one source with one
+ * search, const searches may run on several threads at once
+ * -buildReachability finds the strongly connected components so that
+ * searches between vertices with no path are skipped
+ * -vertex descriptions are stored together in one string and can be
+ * looked up by findVertex
+ * -setUndirected stores each edge once for both directions and
+ * Table T only keeps the upper half of the shortest paths
  *
  * Assumptions:
- * -file is in correct format
+ * -file is in correct format, an edge line "src dest -n" is followed
+ * by the n (departure time, travel time) breakpoints of its profile
  * -valid vertices are entered along with
  * valid weights (non negative)
 
@@ -33,34 +58,80 @@
 #pragma once
 #include <iostream>
 #include "Vertex.h"
+#include <algorithm>
+#include <bitset>
 #include <limits>
 #include <queue>
+#include <type_traits>
 #include <vector>
 
 class Graph
 {
 
+public:
+
+	//orderings of the vertices array available to reorderVertices
+	enum VertexOrder {
+		INPUT_ORDER, // vertex numbers as read in from the file
+		BFS_ORDER, // breadth first order of the edges
+		RCM_ORDER, // reverse Cuthill-McKee order
+		DEGREE_ORDER // vertices with the most edges first
+	};
+
+	//formats displayAll can write the graphs information in
+	enum OutputFormat {
+		TEXT_FORMAT, // table with the descriptions of the vertices
+		CSV_FORMAT, // from,to,dist,path rows
+		JSON_LINES_FORMAT // one JSON object per path
+	};
+
+	//a path found by the route searches
+	struct Route {
+		int dist = 0; // length of the path
+		vector<int> path; // vertex numbers from source to dest
+	};
+
+	//one of the nearest sources of a vertex found by findNearestSources
+	struct SourceLabel {
+		int source = 0; // vertex number of the source
+		int dist = 0; // distance from the source, including its offset
+		int path = 0; // previous vertex number on the path, 0 at source
+	};
+
 private:
 
-	//max number of vertices allowed in graph 
-	static const int MAX_VERTICES = 101;
+	//max number of vertices allowed in graph, Table T grows with the
+	//graph so only the per vertex arrays are this long
+	static const int MAX_VERTICES = 1001;
 
 	//EdgeNode represents the edge between two vertices
 	struct EdgeNode {
 		int adjVertex = 0; // subscript of the adjacent vertex 
 		int weight = 0; // weight of edge
+		int profile = -1; // travel time profile of edge, -1 if none
 		EdgeNode* nextEdge = nullptr;
 	};
 
 	//the source vertex that points to EdgeNodes
 	struct VertexNode {
 		EdgeNode* edgeHead = nullptr; // head of the list of edges
-		Vertex* data = nullptr; // store vertex data here
+		int nameStart = 0; // start of the description in namePool
+		int nameLength = 0; // length of the description
 	};
 
 	// array of VertexNodes
 	VertexNode vertices[MAX_VERTICES];
 
+	// descriptions of all the vertices one after another
+	string namePool;
+
+	// open addressing hash table from description to vertex number,
+	// 0 marks an empty slot, NAME_SLOTS is a power of two at least
+	// twice MAX_VERTICES so probes stay short
+	static const int NAME_SLOTS = 2048;
+	static_assert(NAME_SLOTS >= 2 * MAX_VERTICES, "name index is too small");
+	int nameIndex[NAME_SLOTS] = {};
+
 	// table of information for Dijkstra's algorithm
 	struct Table {
 		bool visited = false; // whether vertex has been visited
@@ -83,12 +154,253 @@ private:
 		}
 	};
 
+	//reusable workspace of the searches that do not fill Table T,
+	//the entries of v are only valid while stamp[v] == current so
+	//that starting a new search does not clear every vertex
+	struct SearchSpace {
+		int dist[MAX_VERTICES]; // shortest known distance from source
+		int path[MAX_VERTICES]; // previous vertex in path of min dist
+		bool visited[MAX_VERTICES]; // whether vertex has been visited
+		unsigned int stamp[MAX_VERTICES] = {};
+		unsigned int current = 0;
+		vector<AdjacentVertex> heap; // heap ordered by CompareAdjacentVertex
+
+		//starts a new search with no vertex reached
+		void start() {
+			heap.clear();
+			if (++current == 0) {
+				fill(stamp, stamp + MAX_VERTICES, 0u);
+				current = 1;
+			}
+		}
+
+		//returns the shortest known distance of v in this search
+		int distance(int v) const {
+			return stamp[v] == current ? dist[v] : numeric_limits<int>::max();
+		}
+
+		//lowers the distance of v to d through prev and queues v,
+		//returns false if v already has a distance of d or less
+		bool relax(int v, int d, int prev) {
+			if (stamp[v] != current) {
+				stamp[v] = current;
+				visited[v] = false;
+			}
+			else if (visited[v] || dist[v] <= d) {
+				return false;
+			}
+			dist[v] = d;
+			path[v] = prev;
+			AdjacentVertex entry;
+			entry.vertexIndex = v;
+			entry.dist = d;
+			heap.push_back(entry);
+			push_heap(heap.begin(), heap.end(), CompareAdjacentVertex());
+			return true;
+		}
+
+		//visits and returns the closest queued vertex that has not been
+		//visited, or 0 when there is none
+		int settle() {
+			while (!heap.empty()) {
+				pop_heap(heap.begin(), heap.end(), CompareAdjacentVertex());
+				AdjacentVertex top = heap.back();
+				heap.pop_back();
+				if (!visited[top.vertexIndex] && top.dist == dist[top.vertexIndex]) {
+					visited[top.vertexIndex] = true;
+					return top.vertexIndex;
+				}
+			}
+			return 0;
+		}
+	};
+
 	int size = 0; // number of vertices in the graph
 
+	// vertex numbers from the file are translated to positions in the
+	// vertices array, toInternal[vertex number] is the position and
+	// toOriginal[position] is the vertex number
+	int toInternal[MAX_VERTICES];
+	int toOriginal[MAX_VERTICES];
+
+	// compressed adjacency list used after compressEdges, the edges of
+	// vertex v are stored from packedStart[v] up to packedStart[v + 1]
+	// in packedEdges, sorted by adjVertex, as variable byte encoded
+	// (adjVertex gap, weight, profile + 1) triples
+	bool compressed = false;
+	int packedStart[MAX_VERTICES + 1] = {};
+	vector<unsigned char> packedEdges;
+
+	// undirected graphs store each edge once, with the edges of the
+	// lower of its two positions, the edges vertex v has with lower
+	// positions are copied to lowerEdges from lowerStart[v] up to
+	// lowerStart[v + 1], in the same form as packedEdges, so that
+	// both directions can be walked
+	bool undirected = false;
+	int lowerStart[MAX_VERTICES + 1] = {};
+	vector<unsigned char> lowerEdges;
+
+	// true while buildGraph inserts the edges of the file, lowerEdges
+	// is built once they are all inserted
+	bool loading = false;
+
+	/**
+	* readPacked
+	* this function decodes one variable byte number (7 bits per byte,
+	* high bit set on all but the last byte) and moves pos past it
+	* Preconditions: pos points to a number written by writePacked
+	* Postconditions: returns the number and pos is moved past it
+	* @param pos: position of the number in packedEdges
+	*/
+	static int readPacked(const unsigned char*& pos) {
+		int number = *pos & 0x7f;
+		for (int shift = 7; *pos++ & 0x80; shift += 7) {
+			number |= (*pos & 0x7f) << shift;
+		}
+		return number;
+	}
+
+	/**
+	* writePacked
+	* this function appends number to bytes as a variable byte number
+	* Preconditions: number is not negative
+	* Postconditions: the encoded number is appended to bytes
+	* @param bytes: buffer to append to
+	* @param number: number to be encoded
+	*/
+	static void writePacked(vector<unsigned char>& bytes, int number);
+
+	//EdgeIterator walks the edges leaving one vertex whether they are
+	//stored as EdgeNodes or compressed, in undirected graphs followed
+	//by the edges stored with lower positions unless only the stored
+	//edges are asked for
+	class EdgeIterator {
+	public:
+		int adjVertex = 0; // subscript of the adjacent vertex
+		int weight = 0; // weight of edge
+		int profile = -1; // travel time profile of edge, -1 if none
+
+		EdgeIterator(const Graph& graph, int vertex, bool storedOnly = false) {
+			if (graph.compressed) {
+				pos = graph.packedEdges.data() + graph.packedStart[vertex];
+				end = graph.packedEdges.data() + graph.packedStart[vertex + 1];
+			}
+			else {
+				node = graph.vertices[vertex].edgeHead;
+			}
+			if (!storedOnly) {
+				lower = graph.lowerEdges.data() + graph.lowerStart[vertex];
+				lowerEnd = graph.lowerEdges.data() + graph.lowerStart[vertex + 1];
+			}
+		}
+
+		//moves to the next edge, returns false after the last edge
+		bool next() {
+			if (node != nullptr) {
+				adjVertex = node->adjVertex;
+				weight = node->weight;
+				profile = node->profile;
+				node = node->nextEdge;
+				return true;
+			}
+			if (pos == end) {
+				if (lower == lowerEnd) {
+					return false;
+				}
+				//continue with the edges from lower positions
+				pos = lower;
+				end = lowerEnd;
+				lower = lowerEnd;
+				adjVertex = 0;
+			}
+			adjVertex += readPacked(pos);
+			weight = readPacked(pos);
+			profile = readPacked(pos) - 1;
+			return true;
+		}
+
+	private:
+		const EdgeNode* node = nullptr;
+		const unsigned char* pos = nullptr;
+		const unsigned char* end = nullptr;
+		const unsigned char* lower = nullptr;
+		const unsigned char* lowerEnd = nullptr;
+	};
+
 	// stores visited, distance, path -
-	// two dimensional in order to solve
-	// for all sources
-	Table T[MAX_VERTICES][MAX_VERTICES];
+	// size rows of size + 1 Tables in order to
+	// solve for all sources, the row of source at
+	// (source - 1) * (size + 1), undirected graphs
+	// pack the entries with source before dest
+	// into size * (size - 1) / 2 Tables, only
+	// allocated by findShortestPath so graphs that
+	// use next hops instead do not hold it
+	vector<Table> T;
+
+	//smallest unsigned type that holds every position, a byte while
+	//MAX_VERTICES is at most 256 and wider if it is raised
+	typedef conditional<MAX_VERTICES <= 256, unsigned char,
+		conditional<MAX_VERTICES <= 65536, unsigned short, unsigned int>::type>::type HopVertex;
+
+	//one run of a next hop row, every destination from firstDest up to
+	//the firstDest of the following run has the same next hop
+	struct NextHopRun {
+		HopVertex firstDest = 0;
+		HopVertex nextHop = 0; // 0 when there is no path
+	};
+
+	// next hop tables found by findNextHops, the row of source is
+	// nextHopRuns[nextHopStart[source]] up to nextHopStart[source + 1]
+	int nextHopStart[MAX_VERTICES + 1] = {};
+	vector<NextHopRun> nextHopRuns;
+
+	//start of a path cache file, followed by size rows of
+	//size + 1 Tables, the row of source at index source - 1
+	struct PathCacheHeader {
+		char magic[8] = {'G', 'R', 'P', 'H', 'T', 'B', 'L', '1'};
+		unsigned long long hash = 0; // graphHash of the cached graph
+		int size = 0; // number of vertices in the graph
+		int tableSize = sizeof(Table); // layout check of the rows
+	};
+
+	// piecewise linear travel time profiles of the edges, profile p
+	// is the (departure time, travel time) breakpoints from
+	// profileStart[p] up to profileStart[p + 1] in profilePoints,
+	// travel times before the first or after the last breakpoint
+	// are those of the first or last breakpoint
+	vector<int> profileStart = vector<int>(1, 0);
+	vector<pair<int, int>> profilePoints;
+	int unusedPoints = 0; // breakpoints of profiles no edge uses
+
+	// cells found by partitionGraph, cellOf[v] is the cell of v and
+	// boundary[v] is true if an edge joins v to another cell, no cells
+	// when cellCount is 0
+	int cellCount = 0;
+	int cellOf[MAX_VERTICES] = {};
+	bool boundary[MAX_VERTICES] = {};
+
+	// overlay of the cells, overlayEdges[b] is (boundary vertex, dist)
+	// for every boundary vertex of the same cell that boundary vertex b
+	// reaches by a path inside the cell
+	vector<vector<pair<int, int>>> overlayEdges;
+
+	// strongly connected components found by buildReachability,
+	// component[v] is the component of v, reaches[c] has bit c2 set if
+	// component c reaches component c2 and reachCount[c] is the number
+	// of vertices component c reaches, only used while reachValid
+	bool reachValid = false;
+	int component[MAX_VERTICES] = {};
+	vector<bitset<MAX_VERTICES>> reaches;
+	int reachCount[MAX_VERTICES] = {};
+
+	// file findShortestPath keeps its results in, none when empty
+	string cacheFile;
+
+	// rows of the mapped path cache file, used instead of Table T
+	// while mapped so rows are only read from disk when displayed
+	const Table* cachedRows = nullptr;
+	size_t cachedLength = 0; // length of the mapping in bytes
+	const void* cachedMapping = nullptr;
 
 	/**
 	* isValidVertex
@@ -101,13 +413,64 @@ private:
 	*/
 	bool isValidVertex(int vertex) const;
 
+	/**
+	* hashName
+	* this function returns the FNV-1a hash of the length characters
+	* starting at name
+	* Preconditons: none
+	* Postconditions: returns the hash of the name
+	*/
+	static unsigned int hashName(const char* name, size_t length);
+
+	/**
+	* addName
+	* this function appends the description of the vertex at position v
+	* to namePool and adds the vertex to nameIndex unless another
+	* vertex already has the same description
+	* Preconditons: v is a position in the vertices array
+	* Postconditions: the description of v is stored
+	* @param v: position of the vertex
+	* @param name: description of the vertex
+	*/
+	void addName(int v, const string& name);
+
+	/**
+	* printName
+	* this function prints the description of the vertex at position v
+	* Preconditons: v is a position in the vertices array
+	* Postconditions: the description is sent to os
+	* @param os: output stream
+	* @param v: position of the vertex
+	*/
+	void printName(ostream& os, int v) const;
+
+	/**
+	* hasEdges
+	* this function returns if any edge leaves vertex, in either
+	* direction in undirected graphs
+	* Preconditons: vertex is a position in the vertices array
+	* Postconditions: returns true if vertex has an edge
+	*/
+	bool hasEdges(int vertex) const;
+
+	/**
+	* expandEdges
+	* this function turns the compressed edges back into lists of
+	* EdgeNodes so that they can be changed, it is called before
+	* any edge is inserted or removed
+	* Preconditons: none
+	* Postconditions: the edges are stored as EdgeNodes
+	*/
+	void expandEdges();
+
 	/**
 	* findEdge
 	* this function takes in a source and dest vertex
 	* and traverses the adjacency list of EdgeNodes in order
 	* to find if the edge exists, if it does, the EdgeNode is
 	* returned and if it does not, nullptr is returned
-	* this function is called by insert
+	* this function is called by insert, in undirected graphs the
+	* edge is looked up with the lower of source and dest
 	* Precondtions: valid source must be entered
 	* Postconditons: if edge is found, EdgeNode is returned, and if
 	* it is not found, nullptr is returned
@@ -161,27 +524,265 @@ private:
 
 	/**
 	* resetTable
-	* this function resets the Table T
+	* this function frees the Table T, findShortestPath
+	* allocates it again
 	* Preconditons: none
-	* Postconditions: the tables values are reset to
-	* their initial values
+	* Postconditions: the Table T is empty
 	*/
 	void resetTable();
 
+	/**
+	* tableLength
+	* this function returns the number of Tables in Table T
+	* Preconditons: none
+	* Postconditions: returns size * (size + 1) for a directed graph
+	* and size * (size - 1) / 2 for an undirected one
+	*/
+	size_t tableLength() const;
+
+	/**
+	* tableEntry
+	* this function returns the shortest path information from source
+	* to dest, from the mapped path cache file if there is one or
+	* Table T
+	* Preconditons: source and dest are positions in the vertices
+	* array, source is before dest in an undirected graph
+	* Postconditions: returns the entry of source and dest
+	* @param source: the source vertex of the entry
+	* @param dest: the destination vertex of the entry
+	*/
+	const Table& tableEntry(int source, int dest) const;
+
+	/**
+	* graphHash
+	* this function returns a hash of the vertices and edges (in the
+	* order they are stored), the results of findShortestPath only
+	* depend on these
+	* Preconditons: none
+	* Postconditions: returns the hash of the graph
+	*/
+	unsigned long long graphHash() const;
+
+	/**
+	* mapPathCache
+	* this function maps the path cache file into memory if it holds
+	* the results for a graph with the given hash
+	* Preconditons: cacheFile is set
+	* Postconditions: returns true and cachedRows points to the rows
+	* if the file is valid, otherwise returns false
+	* @param hash: graphHash of the current graph
+	*/
+	bool mapPathCache(unsigned long long hash);
+
+	/**
+	* writePathCache
+	* this function writes Table T to the path cache file
+	* Preconditons: cacheFile is set and Table T is filled in
+	* Postconditions: the path cache file holds Table T
+	* @param hash: graphHash of the current graph
+	*/
+	void writePathCache(unsigned long long hash) const;
+
+	/**
+	* unmapPathCache
+	* this function unmaps the path cache file, it is called whenever
+	* the graph changes since the cached rows no longer apply
+	* Preconditons: none
+	* Postconditions: the file is unmapped and Table T is reset if it
+	* was mapped
+	*/
+	void unmapPathCache();
+
+	/**
+	* appendNumber
+	* this function appends the decimal digits of number to out
+	* Preconditons: none
+	* Postconditions: number is appended to out
+	* @param out: buffer to append to
+	* @param number: number to be appended
+	*/
+	static void appendNumber(string& out, int number);
+
+	/**
+	* workspace
+	* this function returns the SearchSpace of the calling thread
+	* Preconditons: none
+	* Postconditions: returns the SearchSpace of the calling thread
+	*/
+	static SearchSpace& workspace();
+
+	/**
+	* travelTime
+	* this function returns the travel time of an edge leaving at
+	* time departure by interpolating between the breakpoints of its
+	* profile
+	* Preconditons: none
+	* Postconditions: returns the travel time of the edge
+	* @param weight: the weight of the edge, used if it has no profile
+	* @param profile: the profile of the edge or -1
+	* @param departure: the time the edge is entered
+	*/
+	int travelTime(int weight, int profile, int departure) const;
+
+	/**
+	* releaseProfile
+	* this function removes the travel time profile of edge, its
+	* breakpoints stay in profilePoints until more than half of them
+	* are unused and the profiles are compacted
+	* Preconditons: the edges are stored as EdgeNodes
+	* Postconditions: edge has no profile
+	* @param edge: the edge to remove the profile of
+	*/
+	void releaseProfile(EdgeNode* edge);
+
+	/**
+	* compactProfiles
+	* this function moves the profiles that edges still use to the
+	* front of profilePoints and renumbers them
+	* Preconditons: the edges are stored as EdgeNodes
+	* Postconditions: profilePoints only holds profiles in use
+	*/
+	void compactProfiles();
+
+	/**
+	* findBoundary
+	* this function finds the boundary vertices of the cells
+	* Preconditons: the graph has been partitioned
+	* Postconditions: boundary is set for every vertex
+	*/
+	void findBoundary();
+
+	/**
+	* cellMask
+	* this function sets outside[v] for every vertex v not in cell
+	* Preconditons: the graph has been partitioned
+	* Postconditions: outside marks the vertices not in cell
+	* @param cell: the cell to keep
+	* @param outside: array of MAX_VERTICES to be set
+	*/
+	void cellMask(int cell, bool outside[]) const;
+
+	/**
+	* customizeCell
+	* this function finds the overlay edges between the boundary
+	* vertices of cell with a search inside the cell from each of them,
+	* only the cell is searched so a change of weight inside a cell
+	* only needs the cell to be customized again
+	* Preconditons: the graph has been partitioned
+	* Postconditions: the overlay edges of cell are found
+	* @param cell: the cell to customize
+	*/
+	void customizeCell(int cell);
+
+	/**
+	* updateOverlay
+	* this function updates the cells of source and dest after the
+	* edge between them was inserted or removed
+	* Preconditons: none
+	* Postconditions: the overlay matches the edges if the graph has
+	* been partitioned
+	* @param source: the source vertex of the edge
+	* @param dest: the destination vertex of the edge
+	*/
+	void updateOverlay(int source, int dest);
+
+	/**
+	* reachable
+	* this function looks up if there can be a path from source to
+	* dest in the reachability index
+	* Preconditons: source and dest are positions of vertices
+	* Postconditions: returns false if there is no path from source to
+	* dest, true if there is or the index has not been built
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	*/
+	bool reachable(int source, int dest) const {
+		return !reachValid || reaches[component[source]].test(component[dest]);
+	}
+
+	/**
+	* searchPath
+	* this function performs dijkstraAlgo from source in space and
+	* stops once dest is visited or the distances pass bound, it does
+	* not enter the vertices set in blockedVertex and does not follow
+	* the edges from spur to the vertices set in blockedNext
+	* Preconditons: source is a position in the vertices array
+	* Postconditions: returns the distance to dest, or the max int if
+	* dest is not reached, space holds the paths of the search
+	* @param space: workspace of the search
+	* @param source: the source vertex of the search
+	* @param dest: the destination vertex, 0 searches every vertex
+	* @param blockedVertex: vertices not to enter or nullptr
+	* @param spur: the vertex the edges of blockedNext leave
+	* @param blockedNext: edges from spur not to follow or nullptr
+	* @param bound: the longest distance to search
+	*/
+	int searchPath(SearchSpace& space, int source, int dest,
+		const bool blockedVertex[], int spur, const bool blockedNext[],
+		int bound) const;
+
+	/**
+	* tracePath
+	* this function returns the positions on the path from source to
+	* dest found by a search in space
+	* Preconditons: dest was reached by a search from source
+	* Postconditions: returns the path from source to dest
+	* @param space: workspace of the search
+	* @param source: the source vertex of the search
+	* @param dest: the destination vertex of the path
+	*/
+	static vector<int> tracePath(const SearchSpace& space, int source, int dest);
+
+	/**
+	* toRoutes
+	* this function turns paths of positions into Routes of vertex
+	* numbers
+	* Preconditons: none
+	* Postconditions: returns the Routes
+	* @param paths: (distance, positions) of each path
+	*/
+	vector<Route> toRoutes(const vector<pair<int, vector<int>>>& paths) const;
+
 	/**
 	* dijkstrasAlgo
-	* this function takes in a VertexNode along with the
-	* vertexNum which represents the VertexNode's vertex position
-	* and perform dijkstraAlgo on the sourceVertex in order to
-	* find the shortest path from the sourceVertex to
-	* all other vertices in the graph (which is stored in Table T)
-	* Preconditons: sourceVertex must be valid vertex
-	* Postconditions: the shortest path information
-	* is stored in the Table T
-	* @param sourceVertex: the source vertex for the algorithm
-	* @param vertexNum: the number vertex of sourceVertex
+	* this function takes in the position of a source vertex and
+	* performs dijkstraAlgo on it in order to find the shortest path
+	* from the source to all other vertices in the graph, which is
+	* stored in row (a row of Table T or any other row of size entries)
+	* Preconditons: source must be valid vertex
+	* Postconditions: the shortest path information is stored in row,
+	* if upperOnly is true only the entries of vertices after source
+	* (and the vertices on their paths) are final
+	* @param source: the source vertex for the algorithm
+	* @param row: the table row to store the shortest paths in
+	* @param upperOnly: whether to stop once the vertices after source
+	* are visited
+	*/
+	void dijkstrasAlgo(int source, Table row[], bool upperOnly = false) const;
+
+	/**
+	* nextHop
+	* this function looks up the next hop stored by findNextHops
+	* for a path from source to dest
+	* Preconditons: source and dest are positions of vertices and the
+	* next hops have been found
+	* Postconditions: returns the position of the vertex after source
+	* on the shortest path to dest, or 0 if there is no path
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	*/
+	int nextHop(int source, int dest) const;
+
+	/**
+	* edgeWeight
+	* this function returns the lowest weight of an edge from source
+	* to dest, used to recover distances from next hops
+	* Preconditons: the edge exists
+	* Postconditions: returns the weight of the edge
+	* @param source: the source vertex of the edge
+	* @param dest: the destination vertex of the edge
 	*/
-	void dijkstrasAlgo(VertexNode sourceVertex, int vertexNum);
+	int edgeWeight(int source, int dest) const;
 
 	/**
 	* printPath
@@ -209,6 +810,96 @@ private:
 	*/
 	void printDestinations(int source, int dest) const;
 
+	/**
+	* relabelVertices
+	* this function moves the vertices in the vertices array so that
+	* the vertex at position sequence[k] is moved to position k and
+	* renumbers the EdgeNodes and the vertex number maps to match
+	* Precondition: sequence holds each position 1-size exactly once
+	* Postcondition: vertices are relabeled and the Table T is reset
+	* @param sequence: the new order of the vertex positions
+	*/
+	void relabelVertices(const int sequence[]);
+
+	/**
+	* homeEdges
+	* this function moves every EdgeNode of an undirected graph to
+	* the lower of its two positions, if the edge is already stored
+	* there the one from the lower vertex number is kept
+	* Precondition: the edges are stored as EdgeNodes
+	* Postcondition: no EdgeNode leads to a lower position
+	*/
+	void homeEdges();
+
+	/**
+	* indexLowerEdges
+	* this function copies the edges of an undirected graph to the
+	* lowerEdges of their higher position, it is called when many
+	* edges change at once
+	* Preconditons: none
+	* Postconditions: lowerEdges matches the stored edges, and is
+	* empty if the graph is directed
+	*/
+	void indexLowerEdges();
+
+	/**
+	* updateLowerEdges
+	* this function rewrites the edge from source in the lowerEdges of
+	* dest after that one edge was inserted, changed or removed, only
+	* the edges of dest are encoded again
+	* Preconditons: the graph is undirected, source is the lower
+	* position and the edges are stored as EdgeNodes
+	* Postconditions: lowerEdges matches the stored edges
+	* @param source: the lower position of the edge
+	* @param dest: the higher position of the edge
+	*/
+	void updateLowerEdges(int source, int dest);
+
+	/**
+	* tableDist
+	* this function returns the shortest distance from source to dest
+	* found by findShortestPath, undirected graphs only store the
+	* entries with source before dest
+	* Preconditons: source and dest are positions of vertices
+	* Postconditions: returns the distance, the max int if no path
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	*/
+	int tableDist(int source, int dest) const;
+
+	/**
+	* tablePath
+	* this function stores the shortest path from source to dest
+	* found by findShortestPath in path, dest first, in undirected
+	* graphs the path is read from the row of the lower of the two
+	* and reversed if source is the higher one
+	* Preconditons: source and dest are positions of vertices, path
+	* has room for size + 1 positions
+	* Postconditions: returns the number of vertices on the path, 0 if
+	* there is no path
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	* @param path: positions of the path, dest first
+	*/
+	int tablePath(int source, int dest, int path[]) const;
+
+	/**
+	* appendTablePath
+	* this function appends the shortest path from source to dest in
+	* an undirected graph to path, the row of the lower of the two
+	* only holds the vertices after it so where the path passes a
+	* vertex x before it the part up to x is the reverse of the path
+	* in the row of x
+	* Preconditons: the graph is undirected and dest is reachable
+	* from source
+	* Postconditions: the path after source, ending with dest, is
+	* appended to path
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	* @param path: positions of the path, source first
+	*/
+	void appendTablePath(int source, int dest, vector<int>& path) const;
+
 
 public:
 
@@ -279,6 +970,22 @@ public:
 	*/
 	void insertEdge(int source, int dest, int weight);
 
+	/**
+	* insertEdge
+	* this function inserts an edge from source to dest, or updates
+	* it if it already exists, whose travel time depends on the time
+	* it is entered, the weight of the edge is its lowest travel time
+	* the breakpoints of the old profile are reused if it has as many
+	* Precondtions: valid source and dest must be entered
+	* Postconditions: edge is inserted with the profile if the
+	* breakpoints are in order of departure time, no travel time is
+	* negative and no later departure arrives earlier (FIFO)
+	* @param source: the source vertex
+	* @param dest: the destination vertex
+	* @param profile: (departure time, travel time) breakpoints
+	*/
+	void insertEdge(int source, int dest, const vector<pair<int, int>>& profile);
+
 	/**
 	* removeEdge
 	* this function takes in a source and dest vertex
@@ -318,6 +1025,18 @@ public:
 	*/
 	void displayAll() const;
 
+	/*
+	* displayAll
+	* this function writes the same information as displayAll() to os
+	* in the given format, the output is built in a local buffer and
+	* written to os in large blocks
+	* Preconditions: none
+	* Postconditions: writes all the graphs information to os
+	* @param os: output stream to write to
+	* @param format: TEXT_FORMAT, CSV_FORMAT or JSON_LINES_FORMAT
+	*/
+	void displayAll(ostream& os, OutputFormat format = TEXT_FORMAT) const;
+
 	/**
 	* display
 	* this function takes in a source vertex and a
@@ -333,5 +1052,270 @@ public:
 	*/
 	void display(int source, int dest) const;
 
+	/**
+	* reorderVertices
+	* this function relabels the positions of the vertices in the
+	* vertices array so that vertices visited close together are
+	* stored close together (BFS_ORDER, RCM_ORDER), so that the
+	* vertices with the most edges are stored first (DEGREE_ORDER), or
+	* back to the order of the file (INPUT_ORDER), vertex numbers used
+	* by the other public functions are not changed
+	* Preconditions: none
+	* Postconditions: vertices are relabeled and findShortestPath must
+	* be called again before displaying paths
+	* @param order: the ordering to store the vertices in
+	*/
+	void reorderVertices(VertexOrder order);
+
+	/**
+	* compressEdges
+	* this function replaces the EdgeNodes of every vertex with the
+	* compressed adjacency list, which takes a few bytes per edge,
+	* the graph can still be searched and displayed, inserting or
+	* removing an edge expands the edges back into EdgeNodes
+	* Preconditions: none
+	* Postconditions: the edges are stored compressed
+	*/
+	void compressEdges();
+
+	/**
+	* findNextHops
+	* this function finds the shortest paths from every vertex like
+	* findShortestPath but only keeps the next vertex on each path,
+	* stored as run length encoded rows, without filling Table T,
+	* distances are added up from the edges when a route is displayed
+	* Preconditons: none
+	* Postconditions: the next hop tables are stored
+	*/
+	void findNextHops();
+
+	/**
+	* displayRoute
+	* this function prints the same information as display by
+	* following the next hops stored by findNextHops
+	* Precondtion: source and dest must be valid vertices and
+	* findNextHops must have been called since the edges last
+	* changed, inserting or removing an edge clears the next hops
+	* Postcondition: information about the path from
+	* source to dest is printed
+	* @param source: the source vertex of path to be printed
+	* @param dest: the destination vertex of path to be printed
+	*/
+	void displayRoute(int source, int dest) const;
+
+	/**
+	* setPathCache
+	* this function sets the file that findShortestPath keeps its
+	* results in, if the file holds the results for the same graph
+	* findShortestPath maps it instead of running dijkstrasAlgo and
+	* rows are read from the file as they are displayed, otherwise
+	* the results are computed and written to the file
+	* Preconditions: none
+	* Postconditions: findShortestPath uses fileName as its cache,
+	* an empty fileName turns off the cache
+	* @param fileName: path of the cache file
+	*/
+	void setPathCache(const string& fileName);
+
+	/**
+	* findKShortestPaths
+	* this function finds the k shortest paths from source to dest that
+	* do not visit a vertex twice (Yen's algorithm), each spur search
+	* stops at dest or once it can not beat the paths already found
+	* Precondtion: source and dest must be valid vertices
+	* Postcondition: returns up to k Routes, shortest first
+	* @param source: the source vertex of the paths
+	* @param dest: the destination vertex of the paths
+	* @param k: the number of paths to find
+	*/
+	vector<Route> findKShortestPaths(int source, int dest, int k) const;
+
+	/**
+	* findAlternativeRoutes
+	* this function finds the shortest path from source to dest and up
+	* to k - 1 alternatives, each the shortest path from source to a
+	* via vertex followed by the shortest path from there to dest,
+	* found from one search forward from source and one search back
+	* from dest, paths that visit a vertex twice are left out
+	* Precondtion: source and dest must be valid vertices
+	* Postcondition: returns up to k Routes, shortest first
+	* @param source: the source vertex of the paths
+	* @param dest: the destination vertex of the paths
+	* @param k: the number of paths to find
+	*/
+	vector<Route> findAlternativeRoutes(int source, int dest, int k) const;
+
+	/**
+	* displayRoutes
+	* this function prints the source, dest, distance and path of
+	* each Route in routes, one Route per line, or -- for a Route
+	* without a path
+	* Precondtion: none
+	* Postcondition: the routes are printed
+	* @param routes: the Routes to be printed
+	*/
+	void displayRoutes(const vector<Route>& routes) const;
+
+	/**
+	* findNearestSources
+	* this function searches from all of the sources at once, each
+	* starting at its offset (or 0 if there are no offsets), and labels
+	* every vertex with its k nearest sources, the distance from each
+	* and the previous vertex on the path from each, which replaces a
+	* search from every source
+	* Precondtion: sources must be valid vertices and offsets must be
+	* empty or the same length as sources
+	* Postcondition: returns the labels of each vertex number, nearest
+	* first, with no labels for vertices no source reaches
+	* @param sources: the source vertices
+	* @param offsets: the starting distance of each source or empty
+	* @param k: the number of sources to find for each vertex
+	*/
+	vector<vector<SourceLabel>> findNearestSources(const vector<int>& sources,
+		const vector<int>& offsets, int k = 1) const;
+
+	/**
+	* displayNearestSources
+	* this function prints each vertex with its nearest sources, the
+	* distance from each and the path from each, one label per line
+	* Precondtion: labels was returned by findNearestSources
+	* Postcondition: the labels are printed
+	* @param labels: the labels of each vertex number
+	*/
+	void displayNearestSources(const vector<vector<SourceLabel>>& labels) const;
+
+	/**
+	* findWithinDistance
+	* this function finds every vertex whose shortest path from source
+	* is no longer than radius (the isochrone of source), the search
+	* stops once the closest queued vertex is farther than radius and
+	* reuses the workspace of the calling thread, so its cost depends
+	* on the number of vertices found rather than the size of the graph
+	* Precondtion: source must be a valid vertex
+	* Postcondition: returns (vertex number, distance) of each vertex
+	* found, closest first, starting with source
+	* @param source: the source vertex of the search
+	* @param radius: the longest distance to search
+	*/
+	vector<pair<int, int>> findWithinDistance(int source, int radius) const;
+
+	/**
+	* findEarliestArrival
+	* this function finds the path from source to dest that arrives
+	* first when leaving source at time departure, using the travel
+	* time profiles of the edges at the time each edge is entered
+	* Precondtion: source and dest must be valid vertices
+	* Postcondition: returns the Route with dist as the travel time,
+	* the path is empty if dest can not be reached
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	* @param departure: the time of leaving source
+	*/
+	Route findEarliestArrival(int source, int dest, int departure) const;
+
+	/**
+	* partitionGraph
+	* this function splits the vertices into cells of up to cellSize
+	* vertices grown breadth first so that few edges join cells, then
+	* finds the overlay edges between the boundary vertices of each cell,
+	* inserting or removing an edge customizes only the cells of its
+	* vertices again
+	* Preconditions: none
+	* Postconditions: the graph is partitioned and the overlay is found,
+	* reorderVertices removes the partition
+	* @param cellSize: the most vertices of a cell
+	*/
+	void partitionGraph(int cellSize);
+
+	/**
+	* findOverlayPath
+	* this function finds the shortest path from source to dest by
+	* searching the edges of the cells of source and dest and only the
+	* overlay edges of every other cell, overlay edges on the path are
+	* then expanded by a search inside their cell
+	* Precondtion: source and dest must be valid vertices and the
+	* graph must be partitioned
+	* Postcondition: returns the Route, the path is empty if dest can
+	* not be reached
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	*/
+	Route findOverlayPath(int source, int dest) const;
+
+	/**
+	* findRoutes
+	* this function finds the shortest path from source to each of
+	* dests with one search that stops once every dest is visited, it
+	* only uses the workspace of the calling thread so it may be called
+	* by several threads at once while the graph is not changed
+	* Precondtion: source and dests must be valid vertices
+	* Postcondition: returns the Route to each of dests in order, the
+	* path is empty if the dest can not be reached
+	* @param source: the source vertex of the paths
+	* @param dests: the destination vertices of the paths
+	*/
+	vector<Route> findRoutes(int source, const vector<int>& dests) const;
+
+	/**
+	* buildReachability
+	* this function finds the strongly connected components of the
+	* graph (Tarjan's algorithm without recursion) and which components
+	* each component reaches, after which searches and display return
+	* right away when there is no path, insertEdge and removeEdge keep
+	* the index up to date once it is built, findShortestPath builds it
+	* Preconditions: none
+	* Postconditions: the reachability index is built
+	*/
+	void buildReachability();
+
+	/**
+	* canReach
+	* this function returns if there is a path from source to dest,
+	* from the reachability index if it is built or a search if not
+	* Precondtion: source and dest must be valid vertices
+	* Postcondition: returns true if there is a path
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	*/
+	bool canReach(int source, int dest) const;
+
+	/**
+	* findVertex
+	* this function looks up a vertex by its description in the hash
+	* index of the descriptions
+	* Precondtion: none
+	* Postcondition: returns the vertex number of the first vertex with
+	* the description name, or 0 if there is none
+	* @param name: the description of the vertex
+	*/
+	int findVertex(const string& name) const;
+
+	/**
+	* display
+	* this function does the same as display for the vertices with the
+	* descriptions source and dest
+	* Precondtion: source and dest must be descriptions of vertices
+	* Postcondition: information about the path from
+	* source to dest is printed
+	* @param source: the description of the source vertex
+	* @param dest: the description of the destination vertex
+	*/
+	void display(const string& source, const string& dest) const;
+
+	/**
+	* setUndirected
+	* this function sets whether the edges are undirected, each
+	* undirected edge is stored once and can be used both ways, the
+	* edges already in the graph are converted, two directions of
+	* the same pair become one edge with the weight of the one from
+	* the lower vertex number, Table T only keeps the entries with
+	* source before dest and the other half is read from them
+	* Preconditions: none
+	* Postconditions: the graph is undirected if isUndirected is true
+	* and findShortestPath must be called again before displaying paths
+	* @param isUndirected: whether the edges are undirected
+	*/
+	void setUndirected(bool isUndirected);
+
 };
 
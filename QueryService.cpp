@@ -0,0 +1,204 @@
+/*
+ * @file QueryService.cpp
+ * @author Katarina McGaughy
+ * QueryService class: The QueryService class answers shortest path
+ * requests for a Graph on a pool of threads. Requests are queued by
+ * source and every queued request from the same source is answered
+ * by one search of the Graph.
+ *
+ * Features:
+ * -submit queues a request and returns a future of its Route
+ * -submit with a callback calls it with the Route when it is found
+ * -requests from the same source are answered together
+ * -queueDepth, completedRequests, completedBatches and
+ * averageLatency report how the service is doing
+ *
+ * Assumptions:
+ * -the Graph is not changed while the QueryService exists
+ *
+ * @version 0.1
+ * @date 2022-2-3
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "QueryService.h"
+#include <memory>
+using namespace std;
+
+/**
+ * constructor
+ * this function starts threads threads that answer requests
+ * from graph
+ * Preconditions: graph is not changed while the service exists
+ * Postconditions: the threads are started
+ * @param graph: the Graph requests are answered from
+ * @param threads: the number of threads, at least 1 is started
+ */
+QueryService::QueryService(const Graph& graph, int threads) : graph(graph) {
+	for (int i = 0; i < max(threads, 1); i++) {
+		workers.push_back(thread(&QueryService::work, this));
+	}
+}
+
+/**
+ * destructor
+ * this function answers the requests still queued and stops the
+ * threads
+ * Preconditions: none
+ * Postconditions: every request is answered and the threads stopped
+ */
+QueryService::~QueryService() {
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	ready.notify_all();
+	for (thread& worker : workers) {
+		worker.join();
+	}
+}
+
+/**
+* submit
+* this function queues a request for the shortest path from source
+* to dest
+* Preconditions: none
+* Postconditions: the request is queued
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+* @return: future of the Route, its path is empty if there is none
+*/
+future<Graph::Route> QueryService::submit(int source, int dest) {
+	shared_ptr<promise<Graph::Route>> result = make_shared<promise<Graph::Route>>();
+	future<Graph::Route> answer = result->get_future();
+	submit(source, dest, [result](const Graph::Route& route) {
+		result->set_value(route);
+	});
+	return answer;
+}
+
+/**
+* submit
+* this function queues a request for the shortest path from source
+* to dest and calls done with the Route on a thread of the pool
+* Preconditions: done does not block for long
+* Postconditions: the request is queued
+* @param source: the source vertex of the path
+* @param dest: the destination vertex of the path
+* @param done: called with the Route, its path is empty if there
+* is none
+*/
+void QueryService::submit(int source, int dest, function<void(const Graph::Route&)> done) {
+	Request request;
+	request.dest = dest;
+	request.done = move(done);
+	request.submitted = chrono::steady_clock::now();
+	{
+		lock_guard<mutex> guard(lock);
+		vector<Request>& queued = pending[source];
+		//a source only waits in line once, later requests join it
+		if (queued.empty()) {
+			sources.push_back(source);
+		}
+		queued.push_back(move(request));
+		depth++;
+	}
+	ready.notify_one();
+}
+
+/**
+* work
+* this function is run by each thread of the pool, it takes the
+* requests of the oldest queued source, answers them with one
+* search and repeats until the service is destroyed
+* Preconditions: none
+* Postconditions: every request queued before the service was
+* destroyed is answered
+*/
+void QueryService::work() {
+	vector<Request> batch;
+	vector<int> dests;
+	for (;;) {
+		int source = 0;
+		{
+			unique_lock<mutex> guard(lock);
+			ready.wait(guard, [this] { return stopping || !sources.empty(); });
+			if (sources.empty()) {
+				return;
+			}
+			source = sources.front();
+			sources.pop_front();
+			map<int, vector<Request>>::iterator queued = pending.find(source);
+			batch.swap(queued->second);
+			pending.erase(queued);
+			depth -= static_cast<int>(batch.size());
+		}
+
+		//one search answers every request of the batch
+		dests.clear();
+		for (const Request& request : batch) {
+			dests.push_back(request.dest);
+		}
+		vector<Graph::Route> routes = graph.findRoutes(source, dests);
+		for (size_t i = 0; i < batch.size(); i++) {
+			batch[i].done(routes[i]);
+		}
+
+		chrono::steady_clock::time_point now = chrono::steady_clock::now();
+		double latency = 0;
+		for (const Request& request : batch) {
+			latency += chrono::duration<double>(now - request.submitted).count();
+		}
+		{
+			lock_guard<mutex> guard(lock);
+			requests += static_cast<long long>(batch.size());
+			batches++;
+			totalLatency += latency;
+		}
+		batch.clear();
+	}
+}
+
+/**
+* queueDepth
+* Preconditions: none
+* Postconditions: returns the number of requests waiting
+*/
+int QueryService::queueDepth() const {
+	lock_guard<mutex> guard(lock);
+	return depth;
+}
+
+/**
+* completedRequests
+* Preconditions: none
+* Postconditions: returns the number of requests answered
+*/
+long long QueryService::completedRequests() const {
+	lock_guard<mutex> guard(lock);
+	return requests;
+}
+
+/**
+* completedBatches
+* Preconditions: none
+* Postconditions: returns the number of searches run, requests
+* per batch is completedRequests / completedBatches
+*/
+long long QueryService::completedBatches() const {
+	lock_guard<mutex> guard(lock);
+	return batches;
+}
+
+/**
+* averageLatency
+* Preconditions: none
+* Postconditions: returns the average seconds from a request being
+* queued to being answered, or 0 if none has been answered
+*/
+double QueryService::averageLatency() const {
+	lock_guard<mutex> guard(lock);
+	return requests == 0 ? 0 : totalLatency / requests;
+}
@@ -0,0 +1,159 @@
+/*
+ * @file QueryService.h
+ * @author Katarina McGaughy
+ * QueryService class: The QueryService class answers shortest path
+ * requests for a Graph on a pool of threads. Requests are queued by
+ * source and every queued request from the same source is answered
+ * by one search of the Graph.
+ *
+ * Features:
+ * -submit queues a request and returns a future of its Route
+ * -submit with a callback calls it with the Route when it is found
+ * -requests from the same source are answered together
+ * -queueDepth, completedRequests, completedBatches and
+ * averageLatency report how the service is doing
+ *
+ * Assumptions:
+ * -the Graph is not changed while the QueryService exists
+ *
+ * @version 0.1
+ * @date 2022-2-3
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Graph.h"
+
+class QueryService
+{
+
+private:
+
+	//a queued request for the path to dest
+	struct Request {
+		int dest = 0; // destination vertex of the request
+		function<void(const Graph::Route&)> done; // called with the Route
+		chrono::steady_clock::time_point submitted; // time it was queued
+	};
+
+	const Graph& graph; // graph the requests are answered from
+
+	mutable mutex lock; // guards every member below
+	condition_variable ready; // signalled when a source is queued
+
+	// queued requests by source, and the sources in the order
+	// their first request was queued
+	map<int, vector<Request>> pending;
+	deque<int> sources;
+
+	int depth = 0; // number of queued requests
+	long long requests = 0; // number of requests answered
+	long long batches = 0; // number of searches run
+	double totalLatency = 0; // seconds from queued to answered
+	bool stopping = false; // set when the service is destroyed
+
+	vector<thread> workers;
+
+	/**
+	* work
+	* this function is run by each thread of the pool, it takes the
+	* requests of the oldest queued source, answers them with one
+	* search and repeats until the service is destroyed
+	* Preconditions: none
+	* Postconditions: every request queued before the service was
+	* destroyed is answered
+	*/
+	void work();
+
+public:
+
+	/**
+	 * constructor
+	 * this function starts threads threads that answer requests
+	 * from graph
+	 * Preconditions: graph is not changed while the service exists
+	 * Postconditions: the threads are started
+	 * @param graph: the Graph requests are answered from
+	 * @param threads: the number of threads, at least 1 is started
+	 */
+	QueryService(const Graph& graph, int threads);
+
+	/**
+	 * destructor
+	 * this function answers the requests still queued and stops the
+	 * threads
+	 * Preconditions: none
+	 * Postconditions: every request is answered and the threads stopped
+	 */
+	~QueryService();
+
+	QueryService(const QueryService&) = delete;
+	QueryService& operator=(const QueryService&) = delete;
+
+	/**
+	* submit
+	* this function queues a request for the shortest path from source
+	* to dest
+	* Preconditions: none
+	* Postconditions: the request is queued
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	* @return: future of the Route, its path is empty if there is none
+	*/
+	future<Graph::Route> submit(int source, int dest);
+
+	/**
+	* submit
+	* this function queues a request for the shortest path from source
+	* to dest and calls done with the Route on a thread of the pool
+	* Preconditions: done does not block for long
+	* Postconditions: the request is queued
+	* @param source: the source vertex of the path
+	* @param dest: the destination vertex of the path
+	* @param done: called with the Route, its path is empty if there
+	* is none
+	*/
+	void submit(int source, int dest, function<void(const Graph::Route&)> done);
+
+	/**
+	* queueDepth
+	* Preconditions: none
+	* Postconditions: returns the number of requests waiting
+	*/
+	int queueDepth() const;
+
+	/**
+	* completedRequests
+	* Preconditions: none
+	* Postconditions: returns the number of requests answered
+	*/
+	long long completedRequests() const;
+
+	/**
+	* completedBatches
+	* Preconditions: none
+	* Postconditions: returns the number of searches run, requests
+	* per batch is completedRequests / completedBatches
+	*/
+	long long completedBatches() const;
+
+	/**
+	* averageLatency
+	* Preconditions: none
+	* Postconditions: returns the average seconds from a request being
+	* queued to being answered, or 0 if none has been answered
+	*/
+	double averageLatency() const;
+
+};
@@ -0,0 +1,209 @@
+/*
+ * @file StressHarness.cpp
+ * @author Katarina McGaughy
+ * StressHarness: builds a random graph and submits requests to a
+ * QueryService from several threads at once, with futures and with
+ * callbacks, while other threads read its metrics and search the
+ * same Graph directly. Every answer is compared with findRoutes run
+ * before the service started. Built with ThreadSanitizer by
+ * "make stress".
+ *
+ * Features:
+ * -usage: stress [seed] [requests]
+ * -requests is the number of requests each submitting thread sends
+ * -checks the distance and ends of every Route, that every request
+ * is answered and that the metrics add up once the service stops
+ *
+ * Assumptions:
+ * -the working directory is writable, the graph file is written
+ * there and removed at the end
+ *
+ * @version 0.1
+ * @date 2022-2-3
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include "Graph.h"
+#include <iostream>
+#include <random>
+#include "QueryService.h"
+#include <thread>
+#include <vector>
+using namespace std;
+
+//file the random graph is written to for buildGraph
+const char* const GRAPH_FILE = "stress_graph.txt";
+
+//threads of the service, threads submitting requests and threads
+//searching the Graph directly
+const int SERVICE_THREADS = 4;
+const int SUBMIT_THREADS = 4;
+const int SEARCH_THREADS = 2;
+
+/**
+* matches
+* this function compares a Route with the one findRoutes found
+* before the service started
+* Preconditions: none
+* Postconditions: returns true if both have the same distance, or
+* neither has a path, and route starts at source and ends at dest
+* @param route: the Route to check
+* @param expected: the Route found before the service started
+* @param source: the source vertex
+* @param dest: the destination vertex
+*/
+bool matches(const Graph::Route& route, const Graph::Route& expected, int source, int dest) {
+	if (route.path.empty() || expected.path.empty()) {
+		return route.path.empty() == expected.path.empty();
+	}
+	return route.dist == expected.dist && route.path.front() == source &&
+		route.path.back() == dest;
+}
+
+int main(int argc, char* argv[]) {
+	unsigned int seed = argc > 1 ? static_cast<unsigned int>(strtoul(argv[1], nullptr, 10)) : 1;
+	int requests = argc > 2 ? atoi(argv[2]) : 2000;
+	mt19937 rng(seed);
+
+	//write a random graph, sparse enough that some pairs have no path
+	int size = 50 + rng() % 50;
+	ofstream outfile(GRAPH_FILE);
+	outfile << size << "\n";
+	for (int v = 1; v <= size; v++) {
+		outfile << "vertex " << v << "\n";
+	}
+	for (int i = 0; i < 2 * size; i++) {
+		outfile << 1 + rng() % size << " " << 1 + rng() % size << " " << rng() % 20 << "\n";
+	}
+	outfile << "0 0 0\n";
+	outfile.close();
+
+	Graph G;
+	ifstream infile(GRAPH_FILE);
+	G.buildGraph(infile);
+	infile.close();
+	remove(GRAPH_FILE);
+	if (rng() % 2 == 0) {
+		G.buildReachability();
+	}
+
+	//every answer is compared with findRoutes run on one thread
+	vector<int> everyVertex;
+	for (int d = 1; d <= size; d++) {
+		everyVertex.push_back(d);
+	}
+	vector<vector<Graph::Route>> expected(size + 1);
+	for (int s = 1; s <= size; s++) {
+		expected[s] = G.findRoutes(s, everyVertex);
+	}
+
+	long long total = static_cast<long long>(SUBMIT_THREADS) * requests;
+	atomic<int> wrong(0);
+	atomic<int> answered(0);
+	atomic<bool> submitting(true);
+	long long completed = 0;
+	int depth = 0;
+	{
+		QueryService Q(G, SERVICE_THREADS);
+		vector<thread> threads;
+
+		//each submitting thread sends half of its requests with
+		//futures and half with callbacks
+		for (int t = 0; t < SUBMIT_THREADS; t++) {
+			unsigned int threadSeed = static_cast<unsigned int>(rng());
+			threads.push_back(thread([&, threadSeed] {
+				mt19937 threadRng(threadSeed);
+				vector<future<Graph::Route>> futures;
+				vector<pair<int, int>> futurePairs;
+				for (int i = 0; i < requests; i++) {
+					int s = 1 + threadRng() % size;
+					int d = 1 + threadRng() % size;
+					if (i % 2 == 0) {
+						futures.push_back(Q.submit(s, d));
+						futurePairs.push_back(make_pair(s, d));
+					}
+					else {
+						Q.submit(s, d, [&, s, d](const Graph::Route& route) {
+							if (!matches(route, expected[s][d - 1], s, d)) {
+								wrong++;
+							}
+							answered++;
+						});
+					}
+				}
+				for (size_t i = 0; i < futures.size(); i++) {
+					int s = futurePairs[i].first;
+					int d = futurePairs[i].second;
+					if (!matches(futures[i].get(), expected[s][d - 1], s, d)) {
+						wrong++;
+					}
+					answered++;
+				}
+			}));
+		}
+
+		//const searches may run on several threads at once
+		for (int t = 0; t < SEARCH_THREADS; t++) {
+			unsigned int threadSeed = static_cast<unsigned int>(rng());
+			threads.push_back(thread([&, threadSeed] {
+				mt19937 threadRng(threadSeed);
+				while (submitting) {
+					int s = 1 + threadRng() % size;
+					vector<Graph::Route> routes = G.findRoutes(s, everyVertex);
+					for (int d = 1; d <= size; d++) {
+						if (!matches(routes[d - 1], expected[s][d - 1], s, d)) {
+							wrong++;
+						}
+					}
+					for (const pair<int, int>& found : G.findWithinDistance(s, numeric_limits<int>::max())) {
+						if (found.second != expected[s][found.first - 1].dist) {
+							wrong++;
+						}
+					}
+				}
+			}));
+		}
+
+		//the metrics are read while requests are answered
+		threads.push_back(thread([&] {
+			while (submitting) {
+				if (Q.queueDepth() < 0 || Q.completedRequests() < Q.completedBatches() ||
+					Q.averageLatency() < 0) {
+					wrong++;
+				}
+				this_thread::yield();
+			}
+		}));
+
+		for (int t = 0; t < SUBMIT_THREADS; t++) {
+			threads[t].join();
+		}
+		submitting = false;
+		for (size_t t = SUBMIT_THREADS; t < threads.size(); t++) {
+			threads[t].join();
+		}
+
+		//completedRequests only counts a batch after its callbacks
+		//have run, give the last callbacks up to ten seconds
+		for (int wait = 0; wait < 10000 && Q.completedRequests() < total; wait++) {
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+		completed = Q.completedRequests();
+		depth = Q.queueDepth();
+	}
+
+	bool passed = wrong == 0 && answered == total && completed == total && depth == 0;
+	if (!passed) {
+		cout << wrong << " wrong answers, " << answered << " of " << total << " answered, "
+			<< completed << " completed, queue depth " << depth << endl;
+	}
+	cout << (passed ? "passed" : "FAILED") << " (seed " << seed << ")" << endl;
+	return passed ? 0 : 1;
+}
@@ -8,6 +8,7 @@
  * -stores a string from istream
  * -operator<< prints out data member vertextName
  * -operator>> stores line from istream in vertexName
+ * -getName returns vertexName
  *
  * Assumptions:
  * -istream getline is valid
@@ -44,10 +45,21 @@ public:
 	 * @return: output stream
 	 */
 	friend ostream& operator<<(ostream& os, const Vertex& v) {
-		cout << v.vertexName;
+		os << v.vertexName;
 		return os;
 	}
 
+	/**
+	 * getName
+	 * this function returns the description of the vertex
+	 * Preconditions: none
+	 * Postconditions: returns vertexName
+	 * @return: the description of the vertex
+	 */
+	const string& getName() const {
+		return vertexName;
+	}
+
 	/**
 	 * operator>>
 	 * this function takes in an istream and Vertex object and sets